@@ -0,0 +1,71 @@
+#ifndef STRUCT_MAPPING_BATCH_MAPPER_H
+#define STRUCT_MAPPING_BATCH_MAPPER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+#include "f_struct.h"
+#include "mapper.h"
+#include "thread_pool.h"
+
+namespace struct_mapping {
+
+template<typename T>
+class BatchMapper {
+public:
+	explicit BatchMapper(unsigned int threads = 0)
+		:	pool(threads) {
+		detail::F<T>::register_types();
+	}
+
+	BatchMapper(const BatchMapper &) = delete;
+	BatchMapper & operator=(const BatchMapper &) = delete;
+
+	std::future<T> submit(std::string_view json_data) {
+		return pool.submit([json_data] {
+			T result_struct{};
+			map_json_to_struct(result_struct, json_data);
+			return result_struct;
+		});
+	}
+
+	template<typename A, typename Documents>
+	void map(std::vector<T, A> & result, const Documents & documents) {
+		std::size_t size = std::size(documents);
+		result.clear();
+		result.resize(size);
+
+		std::atomic<std::size_t> next = 0;
+		std::atomic<bool> failed = false;
+		std::vector<std::future<void>> results;
+		for (std::size_t i = std::min<std::size_t>(pool.size(), size); i != 0; --i) {
+			results.push_back(pool.submit([&] {
+				for (auto index = next++; index < size && !failed; index = next++) {
+					try {
+						map_json_to_struct(result[index], std::string_view(documents[index]));
+					} catch (...) {
+						failed = true;
+						throw;
+					}
+				}
+			}));
+		}
+		detail::ThreadPool::wait(results);
+	}
+
+	unsigned int threads() const {
+		return pool.size();
+	}
+
+private:
+	detail::ThreadPool pool;
+};
+
+}
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef STRUCT_MAPPING_EXTRACT_H
+#define STRUCT_MAPPING_EXTRACT_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "exception.h"
+#include "f.h"
+#include "input.h"
+#include "mapper.h"
+#include "member_string.h"
+#include "raw_json.h"
+
+namespace struct_mapping {
+
+namespace detail {
+
+static constexpr const char * VALUE_START_CHARACTERS = "\"{[tf-0123456789n";
+
+[[noreturn]] inline void throw_not_found(std::string_view pointer) {
+	throw StructMappingException("value not found for json pointer: " + std::string(pointer));
+}
+
+inline std::string json_pointer_token(std::string_view pointer, std::size_t & position) {
+	std::string token;
+	for (++position; position < pointer.size() && pointer[position] != '/'; ++position) {
+		if (pointer[position] != '~') token.push_back(pointer[position]);
+		else if (++position < pointer.size() && (pointer[position] == '0' || pointer[position] == '1')) token.push_back(pointer[position] == '0' ? '~' : '/');
+		else throw StructMappingException("bad json pointer: " + std::string(pointer));
+	}
+	return token;
+}
+
+inline std::size_t json_pointer_index(const std::string & token, std::string_view pointer) {
+	std::size_t index = 0;
+	if (token.empty() || (token.size() > 1 && token.front() == '0') || token.find_first_not_of("0123456789") != std::string::npos || !number_from_chars(token, index)) {
+		throw_not_found(pointer);
+	}
+	return index;
+}
+
+inline char find_member(Input & input, const std::string & token, std::string & storage, std::string_view pointer) {
+	for (const char * expected_characters = "\"}";; expected_characters = "\"") {
+		if (input.wait(expected_characters) == '}') throw_not_found(pointer);
+		bool found = input.get_string_view(storage) == token;
+		input.wait(":");
+		char ch = input.wait(VALUE_START_CHARACTERS);
+		if (found) return ch;
+		input.skip_value(ch, storage, false);
+		if (input.wait(",}") == '}') throw_not_found(pointer);
+	}
+}
+
+inline char find_element(Input & input, std::size_t index, std::string & storage, std::string_view pointer) {
+	for (std::size_t i = 0;; ++i) {
+		char ch = input.wait(i == 0 ? "]\"{[tf-0123456789n" : VALUE_START_CHARACTERS);
+		if (ch == ']') throw_not_found(pointer);
+		if (i == index) return ch;
+		input.skip_value(ch, storage, false);
+		if (input.wait(",]") == ']') throw_not_found(pointer);
+	}
+}
+
+inline char find_value(Input & input, std::string_view pointer, std::string & storage) {
+	if (!pointer.empty() && pointer.front() != '/') throw StructMappingException("bad json pointer: " + std::string(pointer));
+
+	char ch = input.wait(VALUE_START_CHARACTERS);
+	for (std::size_t position = 0; position < pointer.size();) {
+		auto token = json_pointer_token(pointer, position);
+		if (ch == '{') ch = find_member(input, token, storage, pointer);
+		else if (ch == '[') ch = find_element(input, json_pointer_index(token, pointer), storage, pointer);
+		else throw_not_found(pointer);
+	}
+	return ch;
+}
+
+template<typename V>
+inline V extract_number(Input & input, char start_ch, std::string_view pointer) {
+	auto value = input.get_number(start_ch);
+	bool ok;
+	if (is_floating_point_number(value)) {
+		if constexpr (std::is_floating_point_v<V>) {
+			double result = 0;
+			ok = number_from_chars(value, result);
+			if (ok && in_limits<V>(result)) return static_cast<V>(result);
+		} else {
+			throw StructMappingException("bad type (floating point) for json pointer: " + std::string(pointer));
+		}
+	} else {
+		long long result = 0;
+		ok = number_from_chars(value, result);
+		if (ok && in_limits<V>(result)) return static_cast<V>(result);
+	}
+
+	if (!ok) throw StructMappingException("bad number [" + std::string(value) + "] for json pointer: " + std::string(pointer));
+	throw StructMappingException("bad value for json pointer: " + std::string(pointer) + ": " + std::string(value) + " is out of limits of type");
+}
+
+template<typename V>
+inline V extract_value(Input & input, char start_ch, std::string_view pointer, std::string & storage) {
+	static_assert(!is_container_like_v<V>, "struct_mapping::extract: containers are not supported, extract RawJson or elements instead");
+
+	if constexpr (std::is_same_v<V, bool>) {
+		if (start_ch == 't') {
+			input.wait("r");
+			input.wait("u");
+			input.wait("e");
+			return true;
+		} else if (start_ch == 'f') {
+			input.wait("a");
+			input.wait("l");
+			input.wait("s");
+			input.wait("e");
+			return false;
+		}
+	} else if constexpr (is_integer_or_floating_point_v<V>) {
+		if (start_ch == '-' || (start_ch >= '0' && start_ch <= '9')) return extract_number<V>(input, start_ch, pointer);
+	} else if constexpr (is_string_v<V>) {
+		if (start_ch == '\"') {
+			auto value = input.get_string_view(storage);
+			return V(value.data(), value.size());
+		}
+	} else if constexpr (is_string_view_v<V>) {
+		if (start_ch == '\"') return borrow_string(input.get_string_view(storage));
+	} else if constexpr (std::is_enum_v<V>) {
+		if (start_ch == '\"') {
+			input.get_string(storage);
+			return MemberString<V>::from_string(std::string(pointer))(storage);
+		}
+	} else if constexpr (is_raw_json_v<V>) {
+		return V(input.skip_value(start_ch, storage, true));
+	} else {
+		if (start_ch == '{') {
+			V result{};
+			struct_mapping::map_json_to_struct(result, input.skip_value(start_ch, storage, true));
+			return result;
+		}
+	}
+
+	throw StructMappingException("bad type for json pointer: " + std::string(pointer));
+}
+
+}
+
+template<typename V>
+inline V extract(std::string_view json_data, std::string_view pointer) {
+	detail::Input input(json_data.data(), json_data.size());
+	std::string storage;
+
+	auto previous_first = detail::F_source::first;
+	auto previous_last = detail::F_source::last;
+	detail::F_source::first = json_data.data();
+	detail::F_source::last = json_data.data() + json_data.size();
+	try {
+		auto start_ch = detail::find_value(input, pointer, storage);
+		V result = detail::extract_value<V>(input, start_ch, pointer, storage);
+		detail::F_source::first = previous_first;
+		detail::F_source::last = previous_last;
+		return result;
+	} catch (...) {
+		detail::F_source::first = previous_first;
+		detail::F_source::last = previous_last;
+		throw;
+	}
+}
+
+}
+
+#endif
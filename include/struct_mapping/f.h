@@ -1,12 +1,22 @@
 #ifndef STRUCT_MAPPING_F_H
 #define STRUCT_MAPPING_F_H
 
+#include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <limits>
+#include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <unordered_set>
 #include <utility>
+#include <vector>
+
+#include "exception.h"
+#include "raw_json.h"
+#include "thread_pool.h"
 
 namespace struct_mapping::detail {
 
@@ -17,10 +27,19 @@ template<typename T>
 static constexpr bool is_integer_or_floating_point_v = !std::is_same_v<T, bool> && (std::is_integral_v<T> || std::is_floating_point_v<T>);
 
 template<typename T>
-static constexpr bool is_integral_or_floating_point_or_string_v = std::is_integral_v<T> || std::is_floating_point_v<T> || std::is_same_v<T, std::string>;
+static constexpr bool is_string_v = std::is_same_v<T, std::string> || std::is_same_v<T, std::pmr::string>;
+
+template<typename T>
+static constexpr bool is_string_view_v = std::is_same_v<T, std::string_view>;
+
+template<typename T>
+static constexpr bool is_integral_or_floating_point_or_string_v = std::is_integral_v<T> || std::is_floating_point_v<T> || is_string_v<T> || is_string_view_v<T>;
 
 template<typename T>
-static constexpr bool is_complex_v = !is_integral_or_floating_point_or_string_v<T> && !std::is_enum_v<T>;
+static constexpr bool is_raw_json_v = std::is_same_v<T, RawJson>;
+
+template<typename T>
+static constexpr bool is_complex_v = !is_integral_or_floating_point_or_string_v<T> && !std::is_enum_v<T> && !is_raw_json_v<T>;
 
 template<typename, typename = std::void_t<>>
 struct has_mapped_type : std::false_type{};
@@ -40,12 +59,33 @@ struct has_key_type<T, std::void_t<typename T::key_type>> : std::true_type{};
 template<typename T>
 constexpr bool has_key_type_v = has_key_type<T>::value;
 
+template<typename, typename = std::void_t<>>
+struct has_reserve : std::false_type{};
+
+template<typename T>
+struct has_reserve<T, std::void_t<decltype(std::declval<T>().reserve(std::size_t()))>> : std::true_type{};
+
+template<typename T>
+constexpr bool has_reserve_v = has_reserve<T>::value;
+
+template<typename, typename = std::void_t<>>
+struct has_try_emplace : std::false_type{};
+
+template<typename T>
+struct has_try_emplace<T, std::void_t<decltype(std::declval<T>().try_emplace(typename T::const_iterator(), typename T::key_type()))>> : std::true_type{};
+
+template<typename T>
+constexpr bool has_try_emplace_v = has_try_emplace<T>::value;
+
 template<typename, typename = std::void_t<>>
 struct is_container_like : std::false_type{};
 
 template<>
 struct is_container_like<std::string> : std::false_type{};
 
+template<>
+struct is_container_like<std::pmr::string> : std::false_type{};
+
 template<typename T>
 struct is_container_like<T, std::void_t<decltype(std::declval<T>().insert(typename T::iterator(), typename T::value_type()))>> : std::true_type{};
 
@@ -58,27 +98,135 @@ constexpr bool is_array_like_v = is_container_like_v<T> && !has_mapped_type_v<T>
 template<typename T>
 constexpr bool is_map_like_v = is_container_like_v<T> && has_mapped_type_v<T>;
 
+template<typename, typename = std::void_t<>>
+struct uses_memory_resource : std::false_type{};
+
+template<typename T>
+struct uses_memory_resource<T, std::void_t<typename T::allocator_type>>
+	: std::is_same<typename T::allocator_type, std::pmr::polymorphic_allocator<typename T::allocator_type::value_type>>{};
+
+template<typename T>
+constexpr bool uses_memory_resource_v = uses_memory_resource<T>::value;
+
+template<typename T, bool = has_mapped_type_v<T>>
+struct element_type {
+	using type = typename T::value_type;
+};
+
+template<typename T>
+struct element_type<T, true> {
+	using type = typename T::mapped_type;
+};
+
+template<typename T, typename = std::void_t<>>
+struct contains_raw_json : std::bool_constant<is_raw_json_v<T>>{};
+
+template<typename T>
+struct contains_raw_json<T, std::enable_if_t<is_container_like_v<T>>> : contains_raw_json<typename element_type<T>::type>{};
+
+template<typename T>
+constexpr bool contains_raw_json_v = contains_raw_json<T>::value;
+
+template<typename>
+struct is_contiguous_numeric : std::false_type{};
+
+template<typename V, typename A>
+struct is_contiguous_numeric<std::vector<V, A>> : std::bool_constant<is_integer_or_floating_point_v<V>>{};
+
+template<typename T>
+constexpr bool is_contiguous_numeric_v = is_contiguous_numeric<T>::value;
+
 class F_iterate_over {
 public:
 	using SetBool = void(const std::string &, bool);
 	using SetIntegral = void(const std::string &, long long);
 	using SetFloatingPoint = void(const std::string &, double);
-	using SetString = void(const std::string &, const std::string &);
+	using SetString = void(const std::string &, std::string_view);
 	using StartStruct = void(const std::string &);
 	using EndStruct = void();
 	using StartArray = void(const std::string &);
 	using EndArray = void();
+	using SetElements = void(const std::string_view *, std::size_t);
+	using SetRaw = void(const std::string &, std::string_view);
+
+	static inline thread_local std::function<SetBool> set_bool;
+	static inline thread_local std::function<SetIntegral> set_integral;
+	static inline thread_local std::function<SetFloatingPoint> set_floating_point;
+	static inline thread_local std::function<SetString> set_string;
+	static inline thread_local std::function<StartStruct> start_struct;
+	static inline thread_local std::function<EndStruct> end_struct;
+	static inline thread_local std::function<StartArray> start_array;
+	static inline thread_local std::function<EndArray> end_array;
+
+	static inline thread_local std::function<SetElements> set_elements;
+	static inline thread_local std::function<SetRaw> set_raw;
+
+	static inline thread_local ThreadPool * pool = nullptr;
+	static inline thread_local std::size_t chunk_size = 0;
+};
 
-	static inline std::function<SetBool> set_bool;
-	static inline std::function<SetIntegral> set_integral;
-	static inline std::function<SetFloatingPoint> set_floating_point;
-	static inline std::function<SetString> set_string;
-	static inline std::function<StartStruct> start_struct;
-	static inline std::function<EndStruct> end_struct;
-	static inline std::function<StartArray> start_array;
-	static inline std::function<EndArray> end_array;
+class F_raw_json {
+public:
+	static inline bool registered = false;
+};
+
+class F_ignore_unknown {
+public:
+	static inline thread_local bool enabled = false;
 };
 
+class F_projection {
+public:
+	static inline thread_local bool enabled = false;
+};
+
+class F_memory_resource {
+public:
+	static inline thread_local std::pmr::memory_resource * resource = nullptr;
+};
+
+class F_source {
+public:
+	static inline thread_local const char * first = nullptr;
+	static inline thread_local const char * last = nullptr;
+};
+
+inline std::string_view borrow_string(std::string_view value) {
+	std::less<const char *> less;
+	if (!less(value.data(), F_source::first) && !less(F_source::last, value.data() + value.size())) return value;
+
+	if (F_memory_resource::resource == nullptr) {
+		throw StructMappingException("bad value '" + std::string(value) + "' for string_view: value is not in json data and memory resource is not set");
+	}
+
+	auto data = static_cast<char *>(F_memory_resource::resource->allocate(value.size(), 1));
+	std::copy(value.begin(), value.end(), data);
+	return std::string_view(data, value.size());
+}
+
+class F_reuse {
+public:
+	static inline thread_local bool enabled = false;
+};
+
+template<typename V>
+inline void reseat(V & value) {
+	if constexpr (uses_memory_resource_v<V>) {
+		auto resource = F_memory_resource::resource;
+		if (resource == nullptr || value.get_allocator().resource() == resource) return;
+
+		typename V::allocator_type allocator(resource);
+		if (value.empty()) {
+			std::destroy_at(&value);
+			::new (static_cast<void *>(&value)) V(allocator);
+		} else {
+			V reseated(value, allocator);
+			std::destroy_at(&value);
+			::new (static_cast<void *>(&value)) V(std::move(reseated));
+		}
+	}
+}
+
 class F_reset {
 public:
 	using Reset = void(*)();
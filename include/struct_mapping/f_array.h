@@ -1,17 +1,25 @@
 #ifndef STRUCT_MAPPING_F_ARRAY_H
 #define STRUCT_MAPPING_F_ARRAY_H
 
+#include <algorithm>
 #include <functional>
+#include <future>
 #include <limits>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "f.h"
 #include "f_struct.h"
+#include "input.h"
 #include "member_string.h"
+#include "parser.h"
 #include "options/option_not_empty.h"
+#include "thread_pool.h"
+#include "writer.h"
 
 namespace struct_mapping::detail {
 					
@@ -30,25 +38,108 @@ public:
 		NotEmpty<>::check_result(o, name);
 	}
 
-	static void init() {}
+	static void init() {
+		count = 0;
+	}
 
-	static void iterate_over(T & o, const std::string & name) {
+	static void iterate_over(const T & o, const std::string & name) {
 		F_iterate_over::start_array(name);
-		
+
+		if constexpr (is_complex_v<ValueType<T>>) {
+			if (F_iterate_over::pool != nullptr && o.size() > F_iterate_over::chunk_size) {
+				iterate_over_parallel(o);
+				F_iterate_over::end_array();
+				return;
+			}
+		} else if constexpr (is_integer_or_floating_point_v<ValueType<T>>) {
+			if (F_iterate_over::set_elements) {
+				iterate_over_numbers(o);
+				F_iterate_over::end_array();
+				return;
+			}
+		}
+
 		for (auto & v : o) {
 			if constexpr (std::is_same_v<ValueType<T>, bool>) F_iterate_over::set_bool("", v);
 			else if constexpr (std::is_integral_v<ValueType<T>>) F_iterate_over::set_integral("", v);
 			else if constexpr (std::is_floating_point_v<ValueType<T>>) F_iterate_over::set_floating_point("", v);
-			else if constexpr (std::is_same_v<ValueType<T>, std::string>) F_iterate_over::set_string("", v);
+			else if constexpr (is_string_v<ValueType<T>> || is_string_view_v<ValueType<T>>) F_iterate_over::set_string("", v);
 			else if constexpr (std::is_enum_v<ValueType<T>>) F_iterate_over::set_string("",MemberString<ValueType<T>>::to_string()(v));
+			else if constexpr (is_raw_json_v<ValueType<T>>) F_iterate_over::set_raw("", v.get());
 			else F<ValueType<T>>::iterate_over(v, "");
 		}
 
 		F_iterate_over::end_array();
 	}
 
-	static bool release(T &) {
+	static bool read_array(T & o, const std::string & name, Input & input) {
+		if (!used) {
+			if constexpr (!has_key_type_v<T> && is_contiguous_numeric_v<ValueType<T>>) {
+				last_inserted = add(o);
+				F<ValueType<T>>::read_numbers(get_last_inserted(), input);
+				return true;
+			}
+		} else {
+			if constexpr (is_complex_v<ValueType<T>>) {
+				return F<ValueType<T>>::read_array(get_last_inserted(), name, input);
+			}
+		}
+		return false;
+	}
+
+	static void read_numbers(T & o, Input & input) {
+		constexpr const char * EXPECTED_AFTER_START = "]{[\"tf-.0123456789n";
+		constexpr const char * EXPECTED_AFTER_VALUE = "],";
+		constexpr const char * EXPECTED_AFTER_COMMA = "{[\"tf-.0123456789n";
+
+		if (F_reuse::enabled) o.clear();
+
+		for (char ch = input.wait(EXPECTED_AFTER_START); ch != ']'; ch = input.wait(EXPECTED_AFTER_VALUE)) {
+			if (ch == ',') ch = input.wait(EXPECTED_AFTER_COMMA);
+
+			if ((ch >= '0' && ch <= '9') || ch == '-' || ch == '.') {
+				auto value = input.get_number(ch);
+				if (is_floating_point_number(value)) {
+					double floating_point_value;
+					if (!number_from_chars(value, floating_point_value)) throw_bad_number(input, value);
+					append_floating_point(o, floating_point_value);
+				} else {
+					long long integral_value;
+					if (!number_from_chars(value, integral_value)) throw_bad_number(input, value);
+					append_integral(o, integral_value);
+				}
+			} else if (ch == 't') {
+				input.wait("r");
+				input.wait("u");
+				input.wait("e");
+				append_bool(o, true);
+			} else if (ch == 'f') {
+				input.wait("a");
+				input.wait("l");
+				input.wait("s");
+				input.wait("e");
+				append_bool(o, false);
+			} else if (ch == 'n') {
+				input.wait("u");
+				input.wait("l");
+				input.wait("l");
+			} else if (ch == '\"') {
+				std::string value;
+				input.get_string(value);
+				append_string(o, value);
+			} else {
+				throw StructMappingException("bad type (" + std::string(ch == '{' ? "struct" : "array") + ") in array_like at index " + std::to_string(o.size()));
+			}
+		}
+	}
+
+	static void register_types() {
+		if constexpr (is_complex_v<ValueType<T>>) F<ValueType<T>>::register_types();
+	}
+
+	static bool release(T & o) {
 		if (!used) {
+			if (F_reuse::enabled) trim(o);
 			return true;
 		}	else {
 			if constexpr (is_complex_v<ValueType<T>>) {
@@ -63,13 +154,13 @@ public:
 
 	static void reset() {
 		used = false;
+		count = 0;
+		if constexpr (has_key_type_v<T>) spare_nodes().clear();
 	}
 
 	static void set_bool(T & o, const std::string & name, bool value) {
 		if (!used) {
-			if constexpr (std::is_same_v<ValueType<T>, bool>) {
-				last_inserted = insert(o, value);
-			} else throw StructMappingException("bad type (bool) '" + (value ? std::string("true") : std::string("false")) + "' in array_like at index " + std::to_string(o.size()));
+			append_bool(o, value);
 		} else {
 			if constexpr (is_complex_v<ValueType<T>>) {
 				F<ValueType<T>>::set_bool(get_last_inserted(), name, value);
@@ -79,16 +170,7 @@ public:
 
 	static void set_floating_point(T & o, const std::string & name, double value) {
 		if (!used) {
-			if constexpr (std::is_floating_point_v<ValueType<T>>) {
-				if (!detail::in_limits<ValueType<T>>(value)) {
-					throw StructMappingException(
-						"bad value '" + std::to_string(value) + "' in array_like at index " + std::to_string(o.size()) + " is out of limits of type [" +
-						std::to_string(std::numeric_limits<ValueType<T>>::lowest()) +
-						" : " +
-						std::to_string(std::numeric_limits<ValueType<T>>::max()) + "]");
-				}
-				last_inserted = insert(o, static_cast<ValueType<T>>(value));
-			} else throw StructMappingException("bad type (floating point) '" + std::to_string(value) + "' in array_like at index " + std::to_string(o.size()));
+			append_floating_point(o, value);
 		} else {
 			if constexpr (is_complex_v<ValueType<T>>) {
 				F<ValueType<T>>::set_floating_point(get_last_inserted(), name, value);
@@ -98,16 +180,7 @@ public:
 
 	static void set_integral(T & o, const std::string & name, long long value) {
 		if (!used) {
-			if constexpr (detail::is_integer_or_floating_point_v<ValueType<T>>) {
-				if (!detail::in_limits<ValueType<T>>(value)) {
-					throw StructMappingException(
-						"bad value '" + std::to_string(value) + "' in array_like at index " + std::to_string(o.size()) + " is out of limits of type [" +
-						std::to_string(std::numeric_limits<ValueType<T>>::lowest()) +
-						" : " +
-						std::to_string(std::numeric_limits<ValueType<T>>::max()) + "]");
-				}
-				last_inserted = insert(o, static_cast<ValueType<T>>(value));
-			} else throw StructMappingException("bad type (integer) '" + std::to_string(value) + "' in array_like at index " + std::to_string(o.size()));
+			append_integral(o, value);
 		} else {
 			if constexpr (is_complex_v<ValueType<T>>) {
 				F<ValueType<T>>::set_integral(get_last_inserted(), name, value);
@@ -115,13 +188,21 @@ public:
 		}
 	}
 
-	static void set_string(T & o, const std::string & name, const std::string & value) {
+	static void set_raw(T & o, const std::string & name, std::string_view value) {
+		if (!used) {
+			if constexpr (is_raw_json_v<ValueType<T>>) {
+				last_inserted = add(o, value);
+			} else throw StructMappingException("bad type (raw json) in array_like at index " + std::to_string(o.size()));
+		} else {
+			if constexpr (is_complex_v<ValueType<T>>) {
+				F<ValueType<T>>::set_raw(get_last_inserted(), name, value);
+			}
+		}
+	}
+
+	static void set_string(T & o, const std::string & name, std::string_view value) {
 		if (!used) {
-			if constexpr (std::is_same_v<ValueType<T>, std::string>) {
-				last_inserted = insert(o, value);
-			} else if constexpr (std::is_enum_v<ValueType<T>>) {
- 				last_inserted = insert(o, MemberString<ValueType<T>>::from_string()(value));
-			} else throw StructMappingException("bad type (string) '" + value + "' in array_like at index " + std::to_string(o.size()));
+			append_string(o, value);
 		} else {
 			if constexpr (is_complex_v<ValueType<T>>) {
 				F<ValueType<T>>::set_string(get_last_inserted(), name, value);
@@ -129,11 +210,20 @@ public:
 		}
 	}
 
+	static ValueAction value_action([[maybe_unused]] T & o, [[maybe_unused]] const std::string & name) {
+		if (!used) {
+			if constexpr (is_raw_json_v<ValueType<T>>) return ValueAction::Capture;
+		} else {
+			if constexpr (is_complex_v<ValueType<T>>) return F<ValueType<T>>::value_action(get_last_inserted(), name);
+		}
+		return ValueAction::Map;
+	}
+
 	static void use(T & o, const std::string & name) {
 		if constexpr (is_complex_v<ValueType<T>>) {
 			if (!used) {
 				used = true;
-				last_inserted = insert(o, ValueType<T>{});
+				last_inserted = add(o);
 				F<ValueType<T>>::init();
 			}	else {
 				F<ValueType<T>>::use(get_last_inserted(), name);
@@ -142,27 +232,186 @@ public:
 	}
 
 private:
-	static inline Iterator last_inserted;
-	static inline bool used = false;
+	static constexpr std::size_t NUMBERS_BUFFER_SIZE = 4096;
+
+	static inline thread_local std::size_t count = 0;
+	static inline thread_local Iterator last_inserted;
+	static inline thread_local bool used = false;
+
+	static void append_bool(T & o, bool value) {
+		if constexpr (std::is_same_v<ValueType<T>, bool>) {
+			last_inserted = add(o, value);
+		} else throw StructMappingException("bad type (bool) '" + (value ? std::string("true") : std::string("false")) + "' in array_like at index " + std::to_string(o.size()));
+	}
+
+	static void append_floating_point(T & o, double value) {
+		if constexpr (std::is_floating_point_v<ValueType<T>>) {
+			if (!detail::in_limits<ValueType<T>>(value)) {
+				throw StructMappingException(
+					"bad value '" + std::to_string(value) + "' in array_like at index " + std::to_string(o.size()) + " is out of limits of type [" +
+					std::to_string(std::numeric_limits<ValueType<T>>::lowest()) +
+					" : " +
+					std::to_string(std::numeric_limits<ValueType<T>>::max()) + "]");
+			}
+			last_inserted = add(o, static_cast<ValueType<T>>(value));
+		} else throw StructMappingException("bad type (floating point) '" + std::to_string(value) + "' in array_like at index " + std::to_string(o.size()));
+	}
+
+	static void append_integral(T & o, long long value) {
+		if constexpr (detail::is_integer_or_floating_point_v<ValueType<T>>) {
+			if (!detail::in_limits<ValueType<T>>(value)) {
+				throw StructMappingException(
+					"bad value '" + std::to_string(value) + "' in array_like at index " + std::to_string(o.size()) + " is out of limits of type [" +
+					std::to_string(std::numeric_limits<ValueType<T>>::lowest()) +
+					" : " +
+					std::to_string(std::numeric_limits<ValueType<T>>::max()) + "]");
+			}
+			last_inserted = add(o, static_cast<ValueType<T>>(value));
+		} else throw StructMappingException("bad type (integer) '" + std::to_string(value) + "' in array_like at index " + std::to_string(o.size()));
+	}
+
+	static void append_string(T & o, std::string_view value) {
+		if constexpr (is_string_v<ValueType<T>>) {
+			last_inserted = add(o, value);
+		} else if constexpr (is_string_view_v<ValueType<T>>) {
+			last_inserted = add(o, borrow_string(value));
+		} else if constexpr (std::is_enum_v<ValueType<T>>) {
+			last_inserted = add(o, MemberString<ValueType<T>>::from_string()(std::string(value)));
+		} else throw StructMappingException("bad type (string) '" + std::string(value) + "' in array_like at index " + std::to_string(o.size()));
+	}
+
+	[[noreturn]] static void throw_bad_number(Input & input, std::string_view value) {
+		throw StructMappingException(std::string("parser: bad number [") + std::string(value) + std::string("] at line ") + std::to_string(input.line_number));
+	}
 
 	static auto & get_last_inserted() {
 		if constexpr (has_mapped_type_v<T>) return last_inserted->second;
 		else return *last_inserted;
 	}
 
-	template<typename V>
-	static Iterator insert(T & o, const V & value) {
-		if constexpr (has_key_type_v<T>) {
-			if constexpr (std::is_same_v<decltype(std::declval<T>().insert(typename T::key_type())), std::pair<Iterator, bool>>) {
-				auto [it, ok] = o.insert(value);
-				return it;
+	static void iterate_over_numbers(const T & o) {
+		char buffer[NUMBERS_BUFFER_SIZE];
+		std::size_t size = 0;
+
+		for (auto v : o) {
+			if (size > NUMBERS_BUFFER_SIZE - NUMBER_MAX_SIZE - 1) {
+				std::string_view part(buffer, size);
+				F_iterate_over::set_elements(&part, 1);
+				size = 0;
+			}
+
+			if (size != 0) buffer[size++] = ',';
+			size += format_number(buffer + size, v);
+		}
+
+		std::string_view part(buffer, size);
+		F_iterate_over::set_elements(&part, 1);
+	}
+
+	static void iterate_over_parallel(const T & o) {
+		auto & pool = *F_iterate_over::pool;
+		auto chunk_size = std::max<std::size_t>(F_iterate_over::chunk_size, 1);
+		std::vector<std::string> chunks(pool.size() * 2);
+		std::vector<std::string_view> parts;
+		std::vector<std::future<void>> results;
+
+		for (auto first = o.begin(); first != o.end();) {
+			parts.clear();
+			results.clear();
+
+			for (auto & chunk : chunks) {
+				if (first == o.end()) break;
+
+				auto last = first;
+				for (std::size_t i = 0; i < chunk_size && last != o.end(); ++i) ++last;
+
+				chunk.clear();
+				results.push_back(pool.submit([first, last, &chunk] {
+					StringSink sink(chunk);
+					Writer writer(sink);
+					writer.install();
+					for (auto it = first; it != last; ++it) F<ValueType<T>>::iterate_over(*it, "");
+				}));
+
+				first = last;
+			}
+
+			ThreadPool::wait(results);
+
+			for (std::size_t i = 0; i < results.size(); ++i) parts.emplace_back(chunks[i]);
+			F_iterate_over::set_elements(parts.data(), parts.size());
+		}
+	}
+
+	template<typename U = T>
+	static std::vector<typename U::node_type> & spare_nodes() {
+		static thread_local std::vector<typename U::node_type> nodes;
+		return nodes;
+	}
+
+	template<typename ... Args>
+	static Iterator add(T & o, Args && ... args) {
+		if (F_reuse::enabled) {
+			if constexpr (has_key_type_v<T>) {
+				auto & nodes = spare_nodes();
+				if (count++ == 0) {
+					while (!o.empty()) nodes.push_back(o.extract(o.begin()));
+					std::reverse(nodes.begin(), nodes.end());
+				}
+
+				if (!nodes.empty()) {
+					auto node = std::move(nodes.back());
+					nodes.pop_back();
+					overwrite(node.value(), std::forward<Args>(args)...);
+					auto it = o.insert(o.end(), std::move(node));
+					if (!node.empty()) nodes.push_back(std::move(node));
+					return it;
+				}
 			} else {
-				return o.insert(value);
+				auto it = count++ == 0 ? o.begin() : std::next(last_inserted);
+				if (it != o.end()) {
+					overwrite(*it, std::forward<Args>(args)...);
+					return it;
+				}
 			}
+		}
+
+		return emplace(o, std::forward<Args>(args)...);
+	}
+
+	template<typename V, typename ... Args>
+	static void overwrite(V && element, Args && ... args) {
+		if constexpr (sizeof...(Args) != 0) {
+			if constexpr (is_string_v<ValueType<T>>) element.assign(std::forward<Args>(args)...);
+			else element = ValueType<T>(std::forward<Args>(args)...);
+		}
+	}
+
+	static void trim(T & o) {
+		if constexpr (has_key_type_v<T>) {
+			if (count == 0) o.clear();
+			spare_nodes().clear();
 		} else {
-			return o.insert(o.end(), value);
+			o.erase(count == 0 ? o.begin() : std::next(last_inserted), o.end());
 		}
 	}
+
+	template<typename ... Args>
+	static Iterator emplace(T & o, Args && ... args) {
+		if constexpr (uses_memory_resource_v<ValueType<T>> && !uses_memory_resource_v<T>) {
+			if (auto resource = F_memory_resource::resource; resource != nullptr) {
+				return emplace_element(o, std::forward<Args>(args)..., typename ValueType<T>::allocator_type(resource));
+			}
+		}
+
+		return emplace_element(o, std::forward<Args>(args)...);
+	}
+
+	template<typename ... Args>
+	static Iterator emplace_element(T & o, Args && ... args) {
+		if constexpr (has_key_type_v<T>) return o.emplace_hint(o.end(), std::forward<Args>(args)...);
+		else return o.emplace(o.end(), std::forward<Args>(args)...);
+	}
 };
 
 }
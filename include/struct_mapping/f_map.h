@@ -1,16 +1,22 @@
 #ifndef STRUCT_MAPPING_F_MAP_H
 #define STRUCT_MAPPING_F_MAP_H
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "f.h"
 #include "f_struct.h"
+#include "input.h"
 #include "member_string.h"
+#include "parser.h"
 #include "options/option_not_empty.h"
 
 namespace struct_mapping::detail {
@@ -30,25 +36,48 @@ public:
 		NotEmpty<>::check_result(o, name);
 	}
 
-	static void init() {}
+	static void init() {
+		count = 0;
+	}
 
-	static void iterate_over(T & o, const std::string & name) {
+	static void iterate_over(const T & o, const std::string & name) {
 		F_iterate_over::start_struct(name);
 		
 		for (auto & [n, v] : o) {
-			if constexpr (std::is_same_v<ValueType<T>, bool>) F_iterate_over::set_bool(n, v);
-			else if constexpr (std::is_integral_v<ValueType<T>>) F_iterate_over::set_integral(n, v);
-			else if constexpr (std::is_floating_point_v<ValueType<T>>) F_iterate_over::set_floating_point(n, v);
-			else if constexpr (std::is_same_v<ValueType<T>, std::string>) F_iterate_over::set_string(n, v);
-			else if constexpr (std::is_enum_v<ValueType<T>>) F_iterate_over::set_string(n, MemberString<ValueType<T>>::to_string()(v));
-			else F<ValueType<T>>::iterate_over(v, n);
+			if constexpr (std::is_same_v<ValueType<T>, bool>) F_iterate_over::set_bool(to_name(n), v);
+			else if constexpr (std::is_integral_v<ValueType<T>>) F_iterate_over::set_integral(to_name(n), v);
+			else if constexpr (std::is_floating_point_v<ValueType<T>>) F_iterate_over::set_floating_point(to_name(n), v);
+			else if constexpr (is_string_v<ValueType<T>> || is_string_view_v<ValueType<T>>) F_iterate_over::set_string(to_name(n), v);
+			else if constexpr (std::is_enum_v<ValueType<T>>) F_iterate_over::set_string(to_name(n), MemberString<ValueType<T>>::to_string()(v));
+			else if constexpr (is_raw_json_v<ValueType<T>>) F_iterate_over::set_raw(to_name(n), v.get());
+			else F<ValueType<T>>::iterate_over(v, to_name(n));
 		}
 
 		F_iterate_over::end_struct();
 	}
 
-	static bool release(T &) {
+	static bool read_array(T & o, const std::string & name, Input & input) {
+		if (!used) {
+			if constexpr (is_contiguous_numeric_v<ValueType<T>>) {
+				last_inserted = add(o, name);
+				F<ValueType<T>>::read_numbers(get_last_inserted(), input);
+				return true;
+			}
+		} else {
+			if constexpr (is_complex_v<ValueType<T>>) {
+				return F<ValueType<T>>::read_array(get_last_inserted(), name, input);
+			}
+		}
+		return false;
+	}
+
+	static void register_types() {
+		if constexpr (is_complex_v<ValueType<T>>) F<ValueType<T>>::register_types();
+	}
+
+	static bool release(T & o) {
 		if (!used) {
+			if (F_reuse::enabled) trim(o);
 			return true;
 		}	else {
 			if constexpr (is_complex_v<ValueType<T>>) {
@@ -63,12 +92,14 @@ public:
 
 	static void reset() {
 		used = false;
+		count = 0;
+		spare_nodes.clear();
 	}
 
 	static void set_bool(T & o, const std::string & name, bool value) {
 		if (!used) {
 			if constexpr (std::is_same_v<ValueType<T>, bool>) {
-				last_inserted = insert(o, name, value);
+				last_inserted = add(o, name, value);
 			} else throw StructMappingException("bad type (bool) '" + (value ? std::string("true") : std::string("false")) + "' at name '" + name + "' in map_like");
 		} else {
 			if constexpr (is_complex_v<ValueType<T>>) {
@@ -87,7 +118,7 @@ public:
 						" : " +
 						std::to_string(std::numeric_limits<ValueType<T>>::max()) + "]");
 				}
-				last_inserted = insert(o, name, static_cast<ValueType<T>>(value));
+				last_inserted = add(o, name, static_cast<ValueType<T>>(value));
 			} else throw StructMappingException("bad type (floating point) '" + std::to_string(value) + "' at name '" + name + "' in map_like");
 		} else {
 			if constexpr (is_complex_v<ValueType<T>>) {
@@ -106,7 +137,7 @@ public:
 						" : " +
 						std::to_string(std::numeric_limits<ValueType<T>>::max()) + "]");
 				}
-				last_inserted = insert(o, name, static_cast<ValueType<T>>(value));
+				last_inserted = add(o, name, static_cast<ValueType<T>>(value));
 			} else throw StructMappingException("bad type (integer) '" + std::to_string(value) + "' at name '" + name + "' in map_like");
 		} else {
 			if constexpr (is_complex_v<ValueType<T>>) {
@@ -115,13 +146,27 @@ public:
 		}
 	}
 
-	static void set_string(T & o, const std::string & name, const std::string & value) {
+	static void set_raw(T & o, const std::string & name, std::string_view value) {
 		if (!used) {
-			if constexpr (std::is_same_v<ValueType<T>, std::string>) {
-				last_inserted = insert(o, name, value);
+			if constexpr (is_raw_json_v<ValueType<T>>) {
+				last_inserted = add(o, name, value);
+			} else throw StructMappingException("bad type (raw json) at name '" + name + "' in map_like");
+		} else {
+			if constexpr (is_complex_v<ValueType<T>>) {
+				F<ValueType<T>>::set_raw(get_last_inserted(), name, value);
+			}
+		}
+	}
+
+	static void set_string(T & o, const std::string & name, std::string_view value) {
+		if (!used) {
+			if constexpr (is_string_v<ValueType<T>>) {
+				last_inserted = add(o, name, value);
+			} else if constexpr (is_string_view_v<ValueType<T>>) {
+				last_inserted = add(o, name, borrow_string(value));
 			} else if constexpr (std::is_enum_v<ValueType<T>>) {
- 				last_inserted = insert(o, name, MemberString<ValueType<T>>::from_string()(value));
-			} else throw StructMappingException("bad type (string) '" + value + "' at name '" + name + "' in map_like");
+ 				last_inserted = add(o, name, MemberString<ValueType<T>>::from_string()(std::string(value)));
+			} else throw StructMappingException("bad type (string) '" + std::string(value) + "' at name '" + name + "' in map_like");
 		} else {
 			if constexpr (is_complex_v<ValueType<T>>) {
 				F<ValueType<T>>::set_string(get_last_inserted(), name, value);
@@ -129,11 +174,20 @@ public:
 		}
 	}
 
+	static ValueAction value_action([[maybe_unused]] T & o, [[maybe_unused]] const std::string & name) {
+		if (!used) {
+			if constexpr (is_raw_json_v<ValueType<T>>) return ValueAction::Capture;
+		} else {
+			if constexpr (is_complex_v<ValueType<T>>) return F<ValueType<T>>::value_action(get_last_inserted(), name);
+		}
+		return ValueAction::Map;
+	}
+
 	static void use(T & o, const std::string & name) {
 		if constexpr (is_complex_v<ValueType<T>>) {
 			if (!used) {
 				used = true;
-				last_inserted = insert(o, name, ValueType<T>{});
+				last_inserted = add(o, name);
 				F<ValueType<T>>::init();
 			}	else {
 				F<ValueType<T>>::use(get_last_inserted(), name);
@@ -142,21 +196,77 @@ public:
 	}
 
 private:
-	static inline Iterator last_inserted;
-	static inline bool used = false;
+	static inline thread_local std::size_t count = 0;
+	static inline thread_local Iterator last_inserted;
+	static inline thread_local std::vector<typename T::node_type> spare_nodes;
+	static inline thread_local bool used = false;
 
 	static auto & get_last_inserted() {
 		if constexpr (has_mapped_type_v<T>) return last_inserted->second;
 		else return *last_inserted;
 	}
 
-	template<typename V>
-	static Iterator insert(T & o, const std::string & name, const V & value) {
-		if constexpr (std::is_same_v<decltype(std::declval<T>().insert(typename T::value_type())), std::pair<Iterator, bool>>) {
-			auto [it, ok] = o.insert(std::make_pair(name, value));
-			return it;
-		} else if constexpr (std::is_same_v<decltype(std::declval<T>().insert(typename T::value_type())), Iterator>) {
-			return o.insert(std::make_pair(name, value));
+	static const std::string & to_name(const std::string & key) {
+		return key;
+	}
+
+	template<typename K>
+	static std::string to_name(const K & key) {
+		return std::string(key);
+	}
+
+	template<typename ... Args>
+	static Iterator add(T & o, const std::string & name, Args && ... args) {
+		if (F_reuse::enabled) {
+			if (count++ == 0) {
+				while (!o.empty()) spare_nodes.push_back(o.extract(o.begin()));
+				std::reverse(spare_nodes.begin(), spare_nodes.end());
+			}
+
+			if (!spare_nodes.empty()) {
+				auto node = std::move(spare_nodes.back());
+				spare_nodes.pop_back();
+				node.key().assign(name.data(), name.size());
+				overwrite(node.mapped(), std::forward<Args>(args)...);
+				auto it = o.insert(o.end(), std::move(node));
+				if (!node.empty()) spare_nodes.push_back(std::move(node));
+				return it;
+			}
+		}
+
+		return emplace(o, name, std::forward<Args>(args)...);
+	}
+
+	template<typename ... Args>
+	static void overwrite(ValueType<T> & element, Args && ... args) {
+		if constexpr (sizeof...(Args) != 0) {
+			if constexpr (is_string_v<ValueType<T>>) element.assign(std::forward<Args>(args)...);
+			else element = ValueType<T>(std::forward<Args>(args)...);
+		}
+	}
+
+	static void trim(T & o) {
+		if (count == 0) o.clear();
+		spare_nodes.clear();
+	}
+
+	template<typename ... Args>
+	static Iterator emplace(T & o, const std::string & name, Args && ... args) {
+		if constexpr (uses_memory_resource_v<ValueType<T>> && !uses_memory_resource_v<T>) {
+			if (auto resource = F_memory_resource::resource; resource != nullptr) {
+				return emplace_element(o, name, std::forward<Args>(args)..., typename ValueType<T>::allocator_type(resource));
+			}
+		}
+
+		return emplace_element(o, name, std::forward<Args>(args)...);
+	}
+
+	template<typename ... Args>
+	static Iterator emplace_element(T & o, const std::string & name, Args && ... args) {
+		if constexpr (has_try_emplace_v<T> && std::is_same_v<typename T::key_type, std::string>) {
+			return o.try_emplace(o.end(), name, std::forward<Args>(args)...);
+		} else {
+			return o.emplace_hint(o.end(), std::piecewise_construct, std::forward_as_tuple(name), std::forward_as_tuple(std::forward<Args>(args)...));
 		}
 	}
 };
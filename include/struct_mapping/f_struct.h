@@ -5,17 +5,22 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "f.h"
+#include "input.h"
 #include "member_string.h"
+#include "parser.h"
+#include "raw_json.h"
 #include "options/option_bounds.h"
 #include "options/option_default.h"
 #include "options/option_not_empty.h"
 #include "options/option_required.h"
+#include "options/option_reserve.h"
 
 namespace struct_mapping::detail {
 
@@ -31,53 +36,87 @@ public:
 	public:
 		using CheckNotEmpty = void (T&, const std::string &);
 		using Init = void ();
-		using IterateOver = void (T&, const std::string &);
+		using IterateOver = void (const T&, const std::string &);
+		using ReadArray = bool (T&, const std::string &, Input &);
+		using ReadNumbers = bool (T&, Input &);
+		using RegisterTypes = void ();
 		using Release = bool (T&);
+		using Reseat = void (T&);
+		using Reserve = void (T&, std::size_t);
 		using SetBool = void (T&, const std::string &, bool);
 		using SetDefault = void (T&, Index);
 		using SetFloatingPoint = void (T&, const std::string &, double);
 		using SetIntegral = void (T&, const std::string &, long long);
-		using SetString = void (T&, const std::string &, const std::string &);
+		using SetRaw = void (T&, const std::string &, std::string_view);
+		using SetString = void (T&, const std::string &, std::string_view);
 		using Use = void (T&, const std::string &);
+		using GetValueAction = ValueAction (T&, const std::string &);
 
 		template<typename V>
 		Index add(Member_ptr<V> ptr) {
 			f_check_not_empty.emplace_back([ptr] (T & o, const std::string & name_) {F<V>::check_not_empty(o.*ptr, name_);});
 			f_init.emplace_back([] {F<V>::init();});
-			f_iterate_over.emplace_back([ptr] (T & o, const std::string & name_) {F<V>::iterate_over(o.*ptr, name_);});
+			f_iterate_over.emplace_back([ptr] (const T & o, const std::string & name_) {F<V>::iterate_over(o.*ptr, name_);});
+			f_read_array.emplace_back([ptr] (T & o, const std::string & name_, Input & input_) {return F<V>::read_array(o.*ptr, name_, input_);});
+			f_read_numbers.emplace_back([ptr] (T & o, Input & input_) {
+				if constexpr (is_contiguous_numeric_v<V>) {
+					F<V>::read_numbers(o.*ptr, input_);
+					return true;
+				} else return false;
+			});
+			f_register_types.emplace_back([] {F<V>::register_types();});
 			f_release.emplace_back([ptr] (T & o) {return F<V>::release(o.*ptr);});
+			f_reseat.emplace_back([ptr] (T & o) {reseat(o.*ptr);});
+			f_reserve.emplace_back([ptr] (T & o, std::size_t size_) {
+				if constexpr (has_reserve_v<V>) (o.*ptr).reserve((o.*ptr).size() + size_);
+			});
 			f_set_bool.emplace_back([ptr] (T & o, const std::string & name_, bool value_) {F<V>::set_bool(o.*ptr, name_, value_);});
-			f_set_default.emplace_back([ptr] (T & o, Index index_) {o.*ptr = members_default<V>[index_];});
+			f_set_default.emplace_back([ptr] (T & o, Index index_) {
+				reseat(o.*ptr);
+				o.*ptr = members_default<V>[index_];
+			});
 			f_set_floating_point.emplace_back([ptr] (T & o, const std::string & name_, double value_) {F<V>::set_floating_point(o.*ptr, name_, value_);});
 			f_set_integral.emplace_back([ptr] (T & o, const std::string & name_, long long value_) {F<V>::set_integral(o.*ptr, name_, value_);});
-			f_set_string.emplace_back([ptr] (T & o, const std::string & name_, const std::string & value_) {F<V>::set_string(o.*ptr, name_, value_);});
+			f_set_raw.emplace_back([ptr] (T & o, const std::string & name_, std::string_view value_) {F<V>::set_raw(o.*ptr, name_, value_);});
+			f_set_string.emplace_back([ptr] (T & o, const std::string & name_, std::string_view value_) {F<V>::set_string(o.*ptr, name_, value_);});
 			f_use.emplace_back([ptr] (T & o, const std::string & name_) {F<V>::use(o.*ptr, name_);});
+			f_value_action.emplace_back([ptr] (T & o, const std::string & name_) {return F<V>::value_action(o.*ptr, name_);});
 			return static_cast<Index>(f_use.size()) - 1;
 		}
 
 		std::vector<std::function<CheckNotEmpty>> f_check_not_empty;
 		std::vector<std::function<Init>> f_init;
 		std::vector<std::function<IterateOver>> f_iterate_over;
+		std::vector<std::function<ReadArray>> f_read_array;
+		std::vector<std::function<ReadNumbers>> f_read_numbers;
+		std::vector<std::function<RegisterTypes>> f_register_types;
 		std::vector<std::function<Release>> f_release;
+		std::vector<std::function<Reseat>> f_reseat;
+		std::vector<std::function<Reserve>> f_reserve;
 		std::vector<std::function<SetBool>> f_set_bool;
 		std::vector<std::function<SetDefault>> f_set_default;
 		std::vector<std::function<SetFloatingPoint>> f_set_floating_point;
 		std::vector<std::function<SetIntegral>> f_set_integral;
+		std::vector<std::function<SetRaw>> f_set_raw;
 		std::vector<std::function<SetString>> f_set_string;
 		std::vector<std::function<Use>> f_use;
+		std::vector<std::function<GetValueAction>> f_value_action;
 	};
 
 	template<typename V, typename ... U, template<typename> typename ... Options>
 	static void reg(Member_ptr<V> ptr, std::string const & name, Options<U>&& ... options) {
 		if (members_name_index.find(name) == members_name_index.end()) {
 			reg_reset<V>();			
+			if constexpr (contains_raw_json_v<V>) F_raw_json::registered = true;
 
 			members_name_index.emplace(name, static_cast<Index>(members.size()));
 			Member member(name, MemberType<V>{}, std::forward<Options<U>>(options)...);
+			member.index = static_cast<Index>(members.size());
 
 			if constexpr (Member::template get_member_type<V>() == Member::Type::Complex) {
 				member.ptr_index = static_cast<Index>(members_ptr<V>.size());
 				member.deep_index = functions.add(ptr);
+				members_ptr_index<V>.push_back(static_cast<Index>(members.size()));
 				members.push_back(std::move(member));
 				members_ptr<V>.push_back(ptr);
 			} else {
@@ -89,11 +128,12 @@ public:
 					enum_from_string.push_back([ptr, name] (T & o, const std::string & value_) {
 						o.*ptr = MemberString<V>::from_string(name)(value_);
 					});
-					enum_to_string.push_back([ptr, name] (T & o) {
+					enum_to_string.push_back([ptr, name] (const T & o) {
 						return MemberString<V>::to_string(name)(o.*ptr);
 					});
 				}
 
+				members_ptr_index<V>.push_back(static_cast<Index>(members.size()));
 				members.push_back(std::move(member));
 				members_ptr<V>.push_back(ptr);
 			}
@@ -104,12 +144,10 @@ public:
 	}
 
 	static void init() {
-		for (auto & member : members) {
-			member.init();
-		}
+		members_changed.assign(members.size(), false);
 	}
 
-	static void iterate_over(T & o, const std::string & name) {
+	static void iterate_over(const T & o, const std::string & name) {
 		F_iterate_over::start_struct(name);
 		for (auto& member : members) {
 			member.iterate_over(o);
@@ -118,10 +156,33 @@ public:
 		F_iterate_over::end_struct();
 	}
 
+	static bool read_array(T & o, const std::string & name, Input & input) {
+		if (member_deep_index == NO_INDEX) {
+			if (auto it = members_name_index.find(name); it != members_name_index.end() && members[it->second].deep_index != NO_INDEX) {
+				members[it->second].prepare(o);
+				if (functions.f_read_numbers[members[it->second].deep_index](o, input)) {
+					members_changed[it->second] = true;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		return functions.f_read_array[member_deep_index](o, name, input);
+	}
+
+	static void register_types() {
+		if (types_registered) return;
+		types_registered = true;
+
+		[[maybe_unused]] T o{};
+		for (auto & f : functions.f_register_types) f();
+	}
+
 	static bool release(T & o) {
 		if (member_deep_index == NO_INDEX) {
-			for (auto & member : members) {
-				member.release(o);
+			for (Index i = 0; i < members.size(); ++i) {
+				if (selected(i)) members[i].release(o);
 			}
 			return true;
 		}	else if (functions.f_release[member_deep_index](o)) member_deep_index = NO_INDEX;
@@ -175,17 +236,31 @@ public:
 		}	else functions.f_set_integral[member_deep_index](o, name, value);
 	}
 
-	static void set_string(T & o, const std::string & name, const std::string & value) {
+	static void set_raw(T & o, const std::string & name, std::string_view value) {
+		if (member_deep_index == NO_INDEX) {
+			if (auto it = members_name_index.find(name); it == members_name_index.end()) throw StructMappingException("bad member: " + name);
+			else if (members[it->second].type != Member::Type::RawJson) throw StructMappingException("bad type (raw json) for member: " + name);
+			else set<RawJson>(o, value, it->second);
+		}	else {
+			functions.f_set_raw[member_deep_index](o, name, value);
+		}
+	}
+
+	static void set_string(T & o, const std::string & name, std::string_view value) {
 		if (member_deep_index == NO_INDEX) {
 			if (auto it = members_name_index.find(name); it == members_name_index.end()) {
 				throw StructMappingException("bad member: " + name);
 			}	else if (members[it->second].type == Member::Type::Enum) {
-				members[it->second].changed = true;
-				enum_from_string[members[it->second].enum_index](o, value);
-			}	else if (members[it->second].type != Member::Type::String) {
-				throw StructMappingException("bad type (string) for member: " + name);
-			}	else {
+				members_changed[it->second] = true;
+				enum_from_string[members[it->second].enum_index](o, std::string(value));
+			}	else if (members[it->second].type == Member::Type::String) {
 				set<std::string>(o, value, it->second);
+			}	else if (members[it->second].type == Member::Type::PmrString) {
+				set<std::pmr::string>(o, value, it->second);
+			}	else if (members[it->second].type == Member::Type::StringView) {
+				set<std::string_view>(o, value, it->second);
+			}	else {
+				throw StructMappingException("bad type (string) for member: " + name);
 			}
 		}	else {
 			functions.f_set_string[member_deep_index](o, name, value);
@@ -198,11 +273,50 @@ public:
 			else {
 				member_deep_index = members[it->second].deep_index;
 				functions.f_init[member_deep_index]();
-				members[it->second].changed = true;
+				members[it->second].prepare(o);
+				members_changed[it->second] = true;
 			}
 		}	else functions.f_use[member_deep_index](o, name);
 	}
 
+	static ValueAction value_action(T & o, const std::string & name) {
+		if (member_deep_index == NO_INDEX) {
+			if (auto it = members_name_index.find(name); it == members_name_index.end()) {
+				if (F_ignore_unknown::enabled) return ValueAction::Skip;
+			} else if (!selected(it->second)) {
+				return ValueAction::Skip;
+			} else if (members[it->second].type == Member::Type::RawJson) {
+				return ValueAction::Capture;
+			}
+			return ValueAction::Map;
+		}
+
+		return functions.f_value_action[member_deep_index](o, name);
+	}
+
+	template<typename V>
+	static Index member_index(Member_ptr<V> ptr) {
+		for (Index i = 0; i < members_ptr<V>.size(); ++i) {
+			if (members_ptr<V>[i] == ptr) return members_ptr_index<V>[i];
+		}
+		throw StructMappingException("member is not registered");
+	}
+
+	static const std::string & member_name(Index index) {
+		return members[index].name;
+	}
+
+	static std::vector<bool> projection_mask(const std::vector<std::string> & names) {
+		std::vector<bool> mask(members.size(), false);
+		for (auto & name : names) {
+			if (auto it = members_name_index.find(name); it == members_name_index.end()) throw StructMappingException("bad member in projection: " + name);
+			else mask[it->second] = true;
+		}
+		return mask;
+	}
+
+	static inline thread_local const std::vector<bool> * projection = nullptr;
+
 private:
 	class Member {
 	public:
@@ -221,6 +335,9 @@ private:
 			Float,
 			Double,
 			String,
+			PmrString,
+			StringView,
+			RawJson,
 			Enum,
 			Complex,
 		};
@@ -245,16 +362,15 @@ private:
 			if constexpr (std::is_same_v<V, float>) return Member::Type::Float;
 			if constexpr (std::is_same_v<V, double>) return Member::Type::Double;
 			if constexpr (std::is_same_v<V, std::string>) return Member::Type::String;
+			if constexpr (std::is_same_v<V, std::pmr::string>) return Member::Type::PmrString;
+			if constexpr (std::is_same_v<V, std::string_view>) return Member::Type::StringView;
+			if constexpr (is_raw_json_v<V>) return Member::Type::RawJson;
 			if constexpr (std::is_enum_v<V>) return Member::Type::Enum;
 			
 			return Member::Type::Complex;
 		}
 
-		void init() {
-			changed = false;
-		}
-
-		void iterate_over(T & o) {
+		void iterate_over(const T & o) {
 			switch (type) {
 			case Member::Type::Bool: F_iterate_over::set_bool(name, o.*members_ptr<bool>[ptr_index]); break;
 			case Member::Type::Char: F_iterate_over::set_integral(name, o.*members_ptr<char>[ptr_index]); break;
@@ -268,27 +384,36 @@ private:
 			case Member::Type::Float: F_iterate_over::set_floating_point(name, o.*members_ptr<float>[ptr_index]); break;
 			case Member::Type::Double: F_iterate_over::set_floating_point(name, o.*members_ptr<double>[ptr_index]); break;
 			case Member::Type::String: F_iterate_over::set_string(name, o.*members_ptr<std::string>[ptr_index]); break;
+			case Member::Type::PmrString: F_iterate_over::set_string(name, o.*members_ptr<std::pmr::string>[ptr_index]); break;
+			case Member::Type::StringView: F_iterate_over::set_string(name, o.*members_ptr<std::string_view>[ptr_index]); break;
+			case Member::Type::RawJson: F_iterate_over::set_raw(name, (o.*members_ptr<RawJson>[ptr_index]).get()); break;
 			case Member::Type::Enum: F_iterate_over::set_string(name, enum_to_string[enum_index](o)); break;
 			case Member::Type::Complex: functions.f_iterate_over[deep_index](o, name); break;
 			}
 		}
 
+		void prepare(T & o) {
+			if (F_memory_resource::resource != nullptr) functions.f_reseat[deep_index](o);
+			if (reserve_size != 0) functions.f_reserve[deep_index](o, reserve_size);
+		}
+
 		void release(T & o) {
 			process_required();
 			process_default(o);
 			process_not_empty(o);
-			changed = false;
+			members_changed[index] = false;
 		}
 
 		Name name;
 		Index bounds_index = NO_INDEX;
-		bool changed = false;
 		Index default_index = NO_INDEX;
 		Index deep_index;
 		Index enum_index = NO_INDEX;
+		Index index;
 		Index ptr_index;
 		bool option_not_empty = false;
 		bool option_required = false;
+		std::size_t reserve_size = 0;
 		Type type;
 
 	private:
@@ -305,6 +430,9 @@ private:
 				add_option_not_empty<V>();
 			} else if constexpr (std::is_same_v<Required<U>, std::decay_t<Op<U>>>) {
 				add_option_required<V>();
+			} else if constexpr (std::is_same_v<Reserve<U>, std::decay_t<Op<U>>>) {
+				op.template check_option<V>(name);
+				reserve_size = op.get_value();
 			}
 		}
 
@@ -316,9 +444,9 @@ private:
 
 		template<typename V, typename U>
 		void add_option_default(Default<U> & op) {
-			if constexpr (std::is_same_v<V, std::string> && std::is_same_v<U, const char *>) {
-				default_index = static_cast<Index>(members_default<std::string>.size());
-				members_default<std::string>.push_back(op.get_value());
+			if constexpr ((is_string_v<V> && (is_string_v<U> || std::is_same_v<U, const char *>)) || (is_string_view_v<V> && std::is_same_v<U, const char *>)) {
+				default_index = static_cast<Index>(members_default<V>.size());
+				members_default<V>.push_back(V(op.get_value()));
 			}	else if constexpr (std::is_enum_v<V>) {
 				default_index = static_cast<Index>(members_default<std::string>.size());
 				members_default<std::string>.push_back(MemberString<V>::to_string(name)(op.get_value()));
@@ -339,7 +467,7 @@ private:
 		}
 
 		void process_default(T & o) {
-			if (!changed) {
+			if (!members_changed[index]) {
 				switch (type) {
 				case Member::Type::Bool: set_default<bool>(o); break;
 				case Member::Type::Char: set_default<char>(o); break;
@@ -353,6 +481,9 @@ private:
 				case Member::Type::Float: set_default<float>(o); break;
 				case Member::Type::Double: set_default<double>(o); break;
 				case Member::Type::String: set_default<std::string>(o); break;
+				case Member::Type::PmrString: set_default<std::pmr::string>(o); break;
+				case Member::Type::StringView: set_default<std::string_view>(o); break;
+				case Member::Type::RawJson: set_default<RawJson>(o); break;
 				case Member::Type::Enum:
 					if (default_index != NO_INDEX) enum_from_string[enum_index](o, members_default<std::string>[default_index]);
 					break;
@@ -367,6 +498,8 @@ private:
 			if (option_not_empty) {
 				switch (type) {
 				case Member::Type::String: NotEmpty<>::check_result(o.*members_ptr<std::string>[ptr_index], name); break;
+				case Member::Type::PmrString: NotEmpty<>::check_result(o.*members_ptr<std::pmr::string>[ptr_index], name); break;
+				case Member::Type::StringView: NotEmpty<>::check_result(o.*members_ptr<std::string_view>[ptr_index], name); break;
 				case Member::Type::Complex: functions.f_check_not_empty[deep_index](o, name);	break;
 				default: break;
 				}
@@ -374,12 +507,15 @@ private:
 		}
 
 		void process_required() {
-			if (option_required) Required<>::check_result(changed, name); 
+			if (option_required) Required<>::check_result(members_changed[index], name); 
 		}
 
 		template<typename V>
 		void set_default(T & o) {
-			if (default_index != NO_INDEX) o.*members_ptr<V>[ptr_index] = members_default<V>[default_index];
+			if (default_index != NO_INDEX) {
+				reseat(o.*members_ptr<V>[ptr_index]);
+				o.*members_ptr<V>[ptr_index] = members_default<V>[default_index];
+			}
 		}
 	};
 
@@ -387,9 +523,10 @@ private:
 
 	static inline Functions functions;
 	static inline std::vector<std::function<void(T&, const std::string &)>> enum_from_string{};
-	static inline std::vector<std::function<std::string (T&)>> enum_to_string{};
-	static inline Index member_deep_index = NO_INDEX;
+	static inline std::vector<std::function<std::string (const T&)>> enum_to_string{};
+	static inline thread_local Index member_deep_index = NO_INDEX;
 	static inline std::vector<Member> members;
+	static inline thread_local std::vector<bool> members_changed;
 	
 	template<typename V>
 	static inline std::vector<std::function<void(V, const std::string &)>> members_bounds{};
@@ -398,10 +535,15 @@ private:
 	static inline std::vector<V> members_default{};
 	
 	static inline std::unordered_map<typename Member::Name, Index> members_name_index;
+
+	static inline bool types_registered = false;
 	
 	template<typename V>
 	static inline std::vector<Member_ptr<V>> members_ptr{};
 
+	template<typename V>
+	static inline std::vector<Index> members_ptr_index{};
+
 	template<typename V>
 	static void reg_reset() {
 		F_reset::reg(reset);
@@ -420,6 +562,10 @@ private:
 		member_deep_index = NO_INDEX;
 	}
 
+	static bool selected(Index index) {
+		return projection == nullptr || (index < projection->size() && (*projection)[index]);
+	}
+
 	template<typename U, typename V>
 	static void set(T & o, V value, unsigned int index) {
 		if constexpr (is_integer_or_floating_point_v<U>) {
@@ -432,11 +578,23 @@ private:
 			}
 		}
 
-		if (members[index].bounds_index != NO_INDEX) members_bounds<U>[members[index].bounds_index](static_cast<U>(value), members[index].name);
-
-		members[index].changed = true;
+		if constexpr (!is_string_v<U> && !is_string_view_v<U> && !is_raw_json_v<U>) {
+			if (members[index].bounds_index != NO_INDEX) members_bounds<U>[members[index].bounds_index](static_cast<U>(value), members[index].name);
+		}
 
-		o.*members_ptr<U>[members[index].ptr_index] = static_cast<U>(value);
+		members_changed[index] = true;
+
+		if constexpr (is_string_v<U>) {
+			auto & member = o.*members_ptr<U>[members[index].ptr_index];
+			reseat(member);
+			member.assign(value.data(), value.size());
+		} else if constexpr (is_string_view_v<U>) {
+			o.*members_ptr<U>[members[index].ptr_index] = borrow_string(value);
+		} else if constexpr (is_raw_json_v<U>) {
+			(o.*members_ptr<U>[members[index].ptr_index]).set(value);
+		} else {
+			o.*members_ptr<U>[members[index].ptr_index] = static_cast<U>(value);
+		}
 	}
 };
 
@@ -0,0 +1,328 @@
+#ifndef STRUCT_MAPPING_INPUT_H
+#define STRUCT_MAPPING_INPUT_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "exception.h"
+
+namespace struct_mapping::detail {
+
+class Input {
+public:
+	using stream_type = std::basic_istream<char>;
+
+	static constexpr std::size_t BUFFER_SIZE = 16384;
+
+	explicit Input(stream_type * stream_)
+		:	stream(stream_), buffer(BUFFER_SIZE) {}
+
+	Input(const char * data, std::size_t size)
+		:	current(data), last(data + size) {}
+
+	Input(const Input &) = delete;
+	Input & operator=(const Input &) = delete;
+
+	~Input() {
+		give_back();
+	}
+
+	bool contiguous() const {
+		return stream == nullptr;
+	}
+
+	const char * position() const {
+		return current;
+	}
+
+	bool get(char & ch) {
+		if (current == last && !refill()) return false;
+		ch = *current++;
+		return true;
+	}
+
+	void unget() {
+		--current;
+	}
+
+	bool skip_whitespace() {
+		for (char ch; get(ch);) {
+			if (ch == '\n') {
+				++line_number;
+			} else if (ch != ' ' && ch != '\t' && ch != '\r') {
+				unget();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	char wait(const char * characters_) {
+		char test_ch;
+		while (get(test_ch)) {
+			for (const char * characters = characters_; *characters; ++characters) {
+				if (test_ch == *characters) {
+					return test_ch;
+				}
+			}
+
+			if (test_ch == '\n') {
+				++line_number;
+			} else if (test_ch != ' ' && test_ch != '\t' && test_ch != '\r') {
+				throw_unexpected(test_ch);
+			}
+		}
+
+		throw StructMappingException("parser: unexpected end of data");
+	}
+
+	void get_string(std::string & result) {
+		result.clear();
+		for (;;) {
+			auto end = find(current, last, '\"');
+			if (auto escape = find(current, end, '\\'); escape != end) {
+				result.append(current, escape);
+				current = escape + 1;
+				get_escape(result);
+				continue;
+			}
+
+			result.append(current, end);
+			if (end != last) {
+				current = end + 1;
+				return;
+			}
+
+			current = last;
+			if (!refill()) throw StructMappingException("parser: unexpected end of data");
+		}
+	}
+
+	std::string_view get_string_view(std::string & storage) {
+		if (auto end = find(current, last, '\"'); end != last && find(current, end, '\\') == end) {
+			std::string_view result(current, static_cast<std::size_t>(end - current));
+			current = end + 1;
+			return result;
+		}
+
+		get_string(storage);
+		return storage;
+	}
+
+	std::string_view skip_value(char start_ch, std::string & storage, bool capture) {
+		const char * segment = current - 1;
+		bool segmented = false;
+		int depth = 0;
+		bool in_string = false;
+		bool escaped = false;
+
+		auto next = [this, &storage, &segment, &segmented, capture] (char & ch) {
+			if (current == last) {
+				if (capture) {
+					if (!segmented) storage.clear();
+					storage.append(segment, last);
+					segmented = true;
+				}
+				if (!refill()) throw StructMappingException("parser: unexpected end of data");
+				segment = current;
+			}
+			ch = *current++;
+		};
+
+		if (start_ch == '{' || start_ch == '[') depth = 1;
+		else if (start_ch == '\"') in_string = true;
+
+		for (char ch; depth != 0 || in_string;) {
+			if (in_string && !escaped) current = find(current, find(current, last, '\"'), '\\');
+			next(ch);
+			if (in_string) {
+				if (escaped) escaped = false;
+				else if (ch == '\\') escaped = true;
+				else if (ch == '\"') in_string = false;
+			} else if (ch == '\"') {
+				in_string = true;
+			} else if (ch == '{' || ch == '[') {
+				++depth;
+			} else if (ch == '}' || ch == ']') {
+				--depth;
+			} else if (ch == '\n') {
+				++line_number;
+			}
+		}
+
+		if (start_ch != '{' && start_ch != '[' && start_ch != '\"') {
+			for (char ch;;) {
+				next(ch);
+				if (ch == ',' || ch == '}' || ch == ']' || ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n') {
+					--current;
+					break;
+				}
+			}
+		}
+
+		if (!capture) return std::string_view();
+		if (!segmented) return std::string_view(segment, static_cast<std::size_t>(current - segment));
+
+		storage.append(segment, current);
+		return storage;
+	}
+
+	std::string_view get_number(char start_ch) {
+		const char * start = current - 1;
+		while (current != last && is_number_char(*current)) ++current;
+
+		if (current != last || contiguous()) return std::string_view(start, static_cast<std::size_t>(current - start));
+
+		number_buffer.assign(1, start_ch);
+		number_buffer.append(start + 1, current);
+		while (refill()) {
+			start = current;
+			while (current != last && is_number_char(*current)) ++current;
+			number_buffer.append(start, current);
+			if (current != last) break;
+		}
+
+		return number_buffer;
+	}
+
+	size_t line_number = 1;
+
+private:
+	stream_type * stream = nullptr;
+	std::vector<char> buffer;
+	const char * current = nullptr;
+	const char * last = nullptr;
+	std::streamsize last_read = 0;
+	std::string number_buffer;
+
+	static const char * find(const char * first, const char * last_, char ch) {
+		if (first == last_) return last_;
+		auto result = static_cast<const char *>(std::memchr(first, ch, static_cast<std::size_t>(last_ - first)));
+		return result == nullptr ? last_ : result;
+	}
+
+	char get_escape_char() {
+		char ch;
+		if (!get(ch)) throw StructMappingException("parser: unexpected end of data");
+		return ch;
+	}
+
+	unsigned int get_code_unit() {
+		unsigned int code_unit = 0;
+		for (int i = 0; i < 4; ++i) {
+			char ch = get_escape_char();
+			code_unit <<= 4;
+			if (ch >= '0' && ch <= '9') code_unit |= static_cast<unsigned int>(ch - '0');
+			else if (ch >= 'a' && ch <= 'f') code_unit |= static_cast<unsigned int>(ch - 'a' + 10);
+			else if (ch >= 'A' && ch <= 'F') code_unit |= static_cast<unsigned int>(ch - 'A' + 10);
+			else throw_unexpected(ch);
+		}
+		return code_unit;
+	}
+
+	void get_escape(std::string & result) {
+		switch (char ch = get_escape_char()) {
+		case '\"': result.push_back('\"'); break;
+		case '\\': result.push_back('\\'); break;
+		case '/': result.push_back('/'); break;
+		case 'b': result.push_back('\b'); break;
+		case 'f': result.push_back('\f'); break;
+		case 'n': result.push_back('\n'); break;
+		case 'r': result.push_back('\r'); break;
+		case 't': result.push_back('\t'); break;
+		case 'u': {
+			unsigned int code_point = get_code_unit();
+			if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+				if (char next_ch = get_escape_char(); next_ch != '\\') throw_unexpected(next_ch);
+				if (char next_ch = get_escape_char(); next_ch != 'u') throw_unexpected(next_ch);
+				unsigned int low = get_code_unit();
+				if (low < 0xDC00 || low > 0xDFFF) throw StructMappingException("parser: bad unicode escape at line " + std::to_string(line_number));
+				code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+			}
+			append_utf8(result, code_point);
+			break;
+		}
+		default: throw_unexpected(ch);
+		}
+	}
+
+	static void append_utf8(std::string & result, unsigned int code_point) {
+		if (code_point < 0x80) {
+			result.push_back(static_cast<char>(code_point));
+		} else if (code_point < 0x800) {
+			result.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+			result.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+		} else if (code_point < 0x10000) {
+			result.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+			result.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+			result.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+		} else {
+			result.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+			result.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+			result.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+			result.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+		}
+	}
+
+	[[noreturn]] void throw_unexpected(char ch) const {
+		throw StructMappingException(std::string("parser: unexpected character '") + std::string(1, ch) + std::string("' at line ") + std::to_string(line_number));
+	}
+
+	static bool is_number_char(char ch) {
+		return (ch >= '0' && ch <= '9') || ch == '-' || ch == '+' || ch == '.' || ch == 'e' || ch == 'E';
+	}
+
+	bool refill() {
+		if (stream == nullptr || stream->rdbuf() == nullptr) return false;
+
+		auto stream_buffer = stream->rdbuf();
+		auto available = stream_buffer->in_avail();
+		if (available <= 0) {
+			if (stream_type::traits_type::eq_int_type(stream_buffer->sgetc(), stream_type::traits_type::eof())) {
+				stream->setstate(std::ios_base::eofbit);
+				return false;
+			}
+			available = stream_buffer->in_avail();
+			if (available <= 0) available = 1;
+		}
+
+		last_read = stream_buffer->sgetn(buffer.data(), std::min(available, static_cast<std::streamsize>(buffer.size())));
+		current = buffer.data();
+		last = buffer.data() + last_read;
+
+		return last_read > 0;
+	}
+
+	void give_back() {
+		if (stream == nullptr || stream->rdbuf() == nullptr) return;
+
+		auto unread = last - current;
+		if (unread > last_read) return;
+
+		try {
+			for (; unread != 0; --unread) {
+				if (stream_type::traits_type::eq_int_type(stream->rdbuf()->sungetc(), stream_type::traits_type::eof())) return;
+			}
+		} catch (...) {}
+	}
+};
+
+inline bool is_floating_point_number(std::string_view value) {
+	return value.find_first_of(".eE") != std::string_view::npos;
+}
+
+template<typename V>
+inline bool number_from_chars(std::string_view value, V & result) {
+	auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+	return error == std::errc() && end == value.data() + value.size();
+}
+
+}
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef STRUCT_MAPPING_JSON_HANDLER_H
+#define STRUCT_MAPPING_JSON_HANDLER_H
+
+#include <istream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "input.h"
+#include "parser.h"
+
+namespace struct_mapping {
+
+class JsonHandler {
+public:
+	bool on_bool(std::string_view, bool) {return true;}
+	bool on_integral(std::string_view, long long) {return true;}
+	bool on_floating_point(std::string_view, double) {return true;}
+	bool on_string(std::string_view, std::string_view) {return true;}
+	bool on_null(std::string_view) {return true;}
+	bool on_start_struct(std::string_view) {return true;}
+	bool on_end_struct() {return true;}
+	bool on_start_array(std::string_view) {return true;}
+	bool on_end_array() {return true;}
+};
+
+namespace detail {
+
+class StopParsing {};
+
+template<typename Event>
+inline void handle(Event && event) {
+	if constexpr (std::is_same_v<std::invoke_result_t<Event>, bool>) {
+		if (!event()) throw StopParsing{};
+	} else {
+		event();
+	}
+}
+
+template<typename Handler>
+inline bool parse_json(Input & input, Handler & handler) {
+	auto set_bool = [&handler] (const std::string & name, bool value) {
+		handle([&] {return handler.on_bool(std::string_view(name), value);});
+	};
+
+	auto set_integral = [&handler] (const std::string & name, long long value) {
+		handle([&] {return handler.on_integral(std::string_view(name), value);});
+	};
+
+	auto set_floating_point = [&handler] (const std::string & name, double value) {
+		handle([&] {return handler.on_floating_point(std::string_view(name), value);});
+	};
+
+	auto set_string = [&handler] (const std::string & name, std::string_view value) {
+		handle([&] {return handler.on_string(std::string_view(name), value);});
+	};
+
+	auto set_null = [&handler] (const std::string & name) {
+		handle([&] {return handler.on_null(std::string_view(name));});
+	};
+
+	auto start_struct = [&handler] (const std::string & name) {
+		handle([&] {return handler.on_start_struct(std::string_view(name));});
+	};
+
+	auto end_struct = [&handler] {
+		handle([&] {return handler.on_end_struct();});
+	};
+
+	auto start_array = [&handler] (const std::string & name) {
+		handle([&] {return handler.on_start_array(std::string_view(name));});
+	};
+
+	auto end_array = [&handler] {
+		handle([&] {return handler.on_end_array();});
+	};
+
+	Parser jp(
+		set_bool,
+		set_integral,
+		set_floating_point,
+		set_string,
+		set_null,
+		start_struct,
+		end_struct,
+		start_array,
+		end_array);
+
+	try {
+		jp.parse(input);
+	} catch (StopParsing &) {
+		return false;
+	}
+
+	return true;
+}
+
+}
+
+template<typename Handler>
+inline bool parse_json(std::basic_istream<char> & json_data, Handler & handler) {
+	detail::Input input(&json_data);
+	return detail::parse_json(input, handler);
+}
+
+template<typename Handler>
+inline bool parse_json(std::string_view json_data, Handler & handler) {
+	detail::Input input(json_data.data(), json_data.size());
+	return detail::parse_json(input, handler);
+}
+
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef STRUCT_MAPPING_JSON_VIEW_H
+#define STRUCT_MAPPING_JSON_VIEW_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "f.h"
+#include "f_struct.h"
+#include "input.h"
+#include "mapper.h"
+
+namespace struct_mapping {
+
+template<typename T>
+class JsonView {
+public:
+	explicit JsonView(std::string_view json_data_)
+		:	json_data(json_data_) {}
+
+	template<typename V>
+	const V & get(V T::* ptr) {
+		auto index = detail::F<T>::member_index(ptr);
+		if (index >= loaded.size()) loaded.resize(index + 1, false);
+
+		if (!loaded[index]) {
+			auto & name = detail::F<T>::member_name(index);
+			if (auto value = find(name); value != nullptr) map_member(value, name);
+			loaded[index] = true;
+		}
+
+		return object.*ptr;
+	}
+
+private:
+	std::string_view json_data;
+	T object{};
+	std::vector<bool> loaded;
+	std::unordered_map<std::string, const char *> values;
+	std::size_t scanned = 0;
+	bool scan_finished = false;
+	std::string storage;
+
+	const char * find(const std::string & name) {
+		if (auto it = values.find(name); it != values.end()) return it->second;
+		if (scan_finished) return nullptr;
+
+		detail::Input input(json_data.data() + scanned, json_data.size() - scanned);
+		bool first = scanned == 0;
+		if (first) input.wait("{");
+
+		for (;;) {
+			if ((!first && input.wait(",}") == '}') || input.wait(first ? "\"}" : "\"") == '}') {
+				scan_finished = true;
+				return nullptr;
+			}
+			first = false;
+
+			std::string key(input.get_string_view(storage));
+			input.wait(":");
+			char start_ch = input.wait("\"{[tf-0123456789n");
+			auto value = input.position() - 1;
+			input.skip_value(start_ch, storage, false);
+			scanned = static_cast<std::size_t>(input.position() - json_data.data());
+
+			if (auto [it, inserted] = values.emplace(std::move(key), value); inserted && it->first == name) return value;
+		}
+	}
+
+	void map_member(const char * value, const std::string & name) {
+		detail::Input input(value, static_cast<std::size_t>(json_data.data() + json_data.size() - value));
+
+		auto previous_first = detail::F_source::first;
+		auto previous_last = detail::F_source::last;
+		detail::F_source::first = json_data.data();
+		detail::F_source::last = json_data.data() + json_data.size();
+		try {
+			detail::map_json_to_member(object, input, name);
+		} catch (...) {
+			detail::F_source::first = previous_first;
+			detail::F_source::last = previous_last;
+			throw;
+		}
+		detail::F_source::first = previous_first;
+		detail::F_source::last = previous_last;
+	}
+};
+
+}
+
+#endif
@@ -1,43 +1,56 @@
 #ifndef STRUCT_MAPPING_MAPPER_H
 #define STRUCT_MAPPING_MAPPER_H
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
 #include <functional>
+#include <future>
 #include <istream>
+#include <memory_resource>
 #include <ostream>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "debug.h"
 #include "f.h"
 #include "f_struct.h"
 #include "f_array.h"
 #include "f_map.h"
+#include "input.h"
 #include "parser.h"
+#include "projection.h"
+#include "thread_pool.h"
+#include "writer.h"
 
 namespace struct_mapping {
 
-template<typename T>
-inline void map_json_to_struct(T & result_struct, std::basic_istream<char> & json_data) {
-	detail::F_reset::reset();
-	int struct_level = 0;
+namespace detail {
 
+template<typename T>
+inline auto json_to_struct_parser(T & result_struct, Input & input, int & struct_level) {
 	auto set_bool = [&result_struct] (std::string const & name, bool value) {
 		if constexpr (debug) std::cout << "struct_mapping: map_json_to_struct.set_bool: " << name << " : " << std::boolalpha << value << std::endl;
-		detail::F<T>::set_bool(result_struct, name, value);
+		F<T>::set_bool(result_struct, name, value);
 	};
 
 	auto set_integral = [&result_struct] (std::string const & name, long long value) {
 		if constexpr (debug) std::cout << "struct_mapping: map_json_to_struct.set_integral: " << name << " : " << value << std::endl;
-		detail::F<T>::set_integral(result_struct, name, value);
+		F<T>::set_integral(result_struct, name, value);
 	};
 
 	auto set_floating_point = [&result_struct] (std::string const & name, double value) {
 		if constexpr (debug) std::cout << "struct_mapping: map_json_to_struct.set_loating_point: " << name << " : " << value << std::endl;
-		detail::F<T>::set_floating_point(result_struct, name, value);
+		F<T>::set_floating_point(result_struct, name, value);
 	};
 
-	auto set_string = [&result_struct] (std::string const & name, std::string const & value) {
+	auto set_string = [&result_struct] (std::string const & name, std::string_view value) {
 		if constexpr (debug) std::cout << "struct_mapping: map_json_to_struct.set_string: " << name << " : " << value << std::endl;
-		detail::F<T>::set_string(result_struct, name, value);
+		F<T>::set_string(result_struct, name, value);
 	};
 
 	auto set_null = [] (std::string const & name) {
@@ -46,27 +59,39 @@ inline void map_json_to_struct(T & result_struct, std::basic_istream<char> & jso
 
 	auto start_struct = [&result_struct, &struct_level] (std::string const & name) {
 		if constexpr (debug) std::cout << "struct_mapping: map_json_to_struct.start_struct: " << name << std::endl;
-		if (++struct_level == 1) detail::F<T>::init();
-		else detail::F<T>::use(result_struct, name);
+		if (++struct_level == 1) F<T>::init();
+		else F<T>::use(result_struct, name);
 	};
 
 	auto end_struct = [&result_struct, &struct_level] {
 		if constexpr (debug) std::cout << "struct_mapping: map_json_to_struct.end_struct:" << std::endl;
-		detail::F<T>::release(result_struct);
+		F<T>::release(result_struct);
 		--struct_level;
 	};
 
-	auto start_array = [&result_struct] (std::string const & name) {
+	auto start_array = [&result_struct, &input] (std::string const & name) {
 		if constexpr (debug) std::cout << "struct_mapping: map_json_to_struct.start_array: " << name << std::endl;
-		detail::F<T>::use(result_struct, name);
+		if (F<T>::read_array(result_struct, name, input)) return true;
+		F<T>::use(result_struct, name);
+		return false;
 	};
 
 	auto end_array = [&result_struct] {
 		if constexpr (debug) std::cout << "struct_mapping: map_json_to_struct.end_array:" << std::endl;
-		detail::F<T>::release(result_struct);
+		F<T>::release(result_struct);
 	};
 
-	detail::Parser jp(
+	auto get_value_action = [&result_struct] (std::string const & name) {
+		if (!F_raw_json::registered && !F_ignore_unknown::enabled && !F_projection::enabled) return ValueAction::Map;
+		return F<T>::value_action(result_struct, name);
+	};
+
+	auto set_raw = [&result_struct] (std::string const & name, std::string_view value) {
+		if constexpr (debug) std::cout << "struct_mapping: map_json_to_struct.set_raw: " << name << " : " << value << std::endl;
+		F<T>::set_raw(result_struct, name, value);
+	};
+
+	return Parser(
 		set_bool,
 		set_integral,
 		set_floating_point,
@@ -75,164 +100,560 @@ inline void map_json_to_struct(T & result_struct, std::basic_istream<char> & jso
 		start_struct,
 		end_struct,
 		start_array,
-		end_array);
-	
-	jp.parse(&json_data);
+		end_array,
+		get_value_action,
+		set_raw);
 }
 
 template<typename T>
-inline void map_struct_to_json(T & source_struct, std::basic_ostream<char> & json_data) {
-	bool first_element = true;
+inline void map_json_to_struct(T & result_struct, Input & input) {
+	F_reset::reset();
+	int struct_level = 0;
+	json_to_struct_parser(result_struct, input, struct_level).parse(input);
+}
 
-	detail::F_iterate_over::set_bool = [&json_data, &first_element] (std::string const & name, bool value) {
-		if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.set_bool: " << name << " : " << std::boolalpha << value << std::endl;
-		if (!first_element) json_data << ",";
-		if (name.empty()) json_data << std::boolalpha << value;
-		else json_data << "\"" << name << "\":" << std::boolalpha << value;
-		first_element = false;
-	};
+template<typename T, typename Callback>
+inline bool deliver(Callback & callback, T & result_struct) {
+	if constexpr (!std::is_invocable_v<Callback &, T &>) {
+		*callback = result_struct;
+		++callback;
+		return true;
+	} else if constexpr (std::is_same_v<std::invoke_result_t<Callback &, T &>, bool>) {
+		return callback(result_struct);
+	} else {
+		callback(result_struct);
+		return true;
+	}
+}
 
-	detail::F_iterate_over::set_integral = [&json_data, &first_element] (std::string const & name, long long value) {
-		if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.set_integral: " << name << " : " << value << std::endl;
-		if (!first_element) json_data << ",";
-		if (name.empty()) json_data << value;
-		else json_data << "\"" << name << "\":" << value;
-		first_element = false;
-	};
+template<typename T, typename Delivery>
+inline std::size_t map_json_stream(Input & input, T & result_struct, Delivery delivery) {
+	int struct_level = 0;
+	auto parser = json_to_struct_parser(result_struct, input, struct_level);
+	std::size_t count = 0;
 
-	detail::F_iterate_over::set_floating_point = [&json_data, &first_element] (std::string const & name, double value) {
-		if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.set_floating_point: " << name << " : " << value << std::endl;
-		if (!first_element) json_data << ",";
-		if (name.empty()) json_data << value;
-		else json_data << "\"" << name << "\":" << value;
-		first_element = false;
-	};
+	while (input.skip_whitespace()) {
+		F_reset::reset();
+		parser.parse(input);
+		++count;
+		if (!delivery()) break;
+	}
 
-	detail::F_iterate_over::set_string = [&json_data, &first_element] (std::string const & name, std::string value) {
-		if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.set_string: " << name << " : " << value << std::endl;
-		if (!first_element) json_data << ",";
-		if (name.empty()) json_data << "\"" << value << "\"";
-		else json_data << "\"" << name << "\":\"" << value << "\"";
-		first_element = false;
-	};
+	return count;
+}
 
-	detail::F_iterate_over::start_struct = [&json_data, &first_element] (std::string const & name) {
-		if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.start_struct: " << name << std::endl;
-		if (!first_element) json_data << ",";
-		first_element = true;
-		if (name.empty()) json_data << "{";
-		else json_data << "\"" << name << "\":{";
-	};
+inline std::string_view next_records(std::string_view json_data, std::size_t & position, std::size_t records_count) {
+	auto first = position;
+	for (std::size_t i = 0; i < records_count && position < json_data.size(); ++i) {
+		auto end = json_data.find('\n', position);
+		position = end == std::string_view::npos ? json_data.size() : end + 1;
+	}
+	return json_data.substr(first, position - first);
+}
 
-	detail::F_iterate_over::end_struct = [&json_data, &first_element] () {
-		if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.end_struct:" << std::endl;
-		json_data << "}";
-		first_element = false;
-	};
+template<typename T, typename Delivery>
+inline std::size_t map_json_records(std::string_view json_data, std::string_view records, T & result_struct, Delivery delivery) {
+	Input input(records.data(), records.size());
+	F_reuse::enabled = true;
+	F_source::first = json_data.data();
+	F_source::last = json_data.data() + json_data.size();
+	return map_json_stream(input, result_struct, delivery);
+}
 
-	detail::F_iterate_over::start_array = [&json_data, &first_element] (std::string const & name) {
-		if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.start_array: " << name << std::endl;
-		if (!first_element) json_data << ",";
-		first_element = true;
-		if (name.empty()) json_data << "[";
-		else json_data << "\"" << name << "\":[";
-	};
+template<typename T, typename Delivery>
+inline std::size_t map_json_array(Input & input, T & result_struct, Delivery delivery) {
+	static_assert(is_complex_v<T> && !is_container_like_v<T>, "struct_mapping::map_json_array: elements must be structures");
 
-	detail::F_iterate_over::end_array = [&json_data, &first_element] () {
-		if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.end_array:" << std::endl;
-		json_data << "]";
-		first_element = false;
-	};
+	int struct_level = 0;
+	auto parser = json_to_struct_parser(result_struct, input, struct_level);
+	std::size_t count = 0;
+
+	input.wait("[");
+	for (const char * expected_characters = "{]";;) {
+		char ch = input.wait(expected_characters);
+		if (ch == ']') break;
+
+		if (ch == ',') {
+			expected_characters = "{";
+			continue;
+		}
+
+		input.unget();
+		F_reset::reset();
+		parser.parse(input);
+		++count;
+		if (!delivery()) break;
+		expected_characters = ",]";
+	}
+
+	return count;
+}
 
-	detail::F<T>::iterate_over(source_struct, "");
+inline std::vector<std::string_view> split_json_array(std::string_view json_data, std::size_t elements_count) {
+	Input input(json_data.data(), json_data.size());
+	std::string storage;
+	std::vector<std::string_view> ranges;
+	std::size_t count = 0;
+
+	input.wait("[");
+	const char * first = input.position();
+	for (const char * expected_characters = "{]";;) {
+		char ch = input.wait(expected_characters);
+		if (ch == ']') break;
+
+		if (ch == ',') {
+			if (count == elements_count) {
+				ranges.emplace_back(first, static_cast<std::size_t>(input.position() - 1 - first));
+				first = input.position();
+				count = 0;
+			}
+			expected_characters = "{";
+			continue;
+		}
+
+		input.skip_value(ch, storage, false);
+		++count;
+		expected_characters = ",]";
+	}
+
+	if (count != 0) ranges.emplace_back(first, static_cast<std::size_t>(input.position() - 1 - first));
+	return ranges;
+}
+
+template<typename T, typename Delivery>
+inline std::size_t map_json_elements(std::string_view json_data, std::string_view elements, T & result_struct, Delivery delivery) {
+	static_assert(is_complex_v<T> && !is_container_like_v<T>, "struct_mapping::map_json_array: elements must be structures");
+
+	Input input(elements.data(), elements.size());
+	F_source::first = json_data.data();
+	F_source::last = json_data.data() + json_data.size();
+
+	int struct_level = 0;
+	auto parser = json_to_struct_parser(result_struct, input, struct_level);
+	std::size_t count = 0;
+
+	while (input.skip_whitespace()) {
+		if (count != 0) input.wait(",");
+		input.wait("{");
+		input.unget();
+		F_reset::reset();
+		parser.parse(input);
+		++count;
+		if (!delivery()) break;
+	}
+
+	return count;
 }
 
 template<typename T>
-inline void map_struct_to_json(T & source_struct, std::basic_ostream<char> & json_data, std::string indent) {
-	bool first_element = true;
-	int indent_count = 0;
+inline void map_json_to_member(T & result_struct, Input & input, const std::string & name) {
+	F_reset::reset();
+	int struct_level = 1;
+	F<T>::init();
+	json_to_struct_parser(result_struct, input, struct_level).parse_value(input, name);
+}
 
-	detail::F_iterate_over::set_bool = [&json_data, &first_element, &indent_count, &indent] (std::string const & name, bool value) {
-		if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.set_bool: " << name << " : " << std::boolalpha << value << std::endl;
-		if (!first_element) json_data << ",";
- 		json_data << "\n";
-		for (int i = indent_count; i != 0; --i) json_data << indent; 
-		if (name.empty()) json_data << std::boolalpha << value;
-		else json_data << "\"" << name << "\": " << std::boolalpha << value;
-		first_element = false;
-	};
+}
 
-	detail::F_iterate_over::set_integral = [&json_data, &first_element, &indent_count, &indent] (std::string const & name, long long value) {
-		if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.set_integral: " << name << " : " << value << std::endl;
-		if (!first_element) json_data << ",";
- 		json_data << "\n";
-		for (int i = indent_count; i != 0; --i) json_data << indent; 
-		if (name.empty()) json_data << value;
-		else json_data << "\"" << name << "\": " << value;
-		first_element = false;
-	};
+template<typename T>
+inline void map_json_to_struct(T & result_struct, std::basic_istream<char> & json_data) {
+	detail::Input input(&json_data);
+	detail::map_json_to_struct(result_struct, input);
+}
 
-	detail::F_iterate_over::set_floating_point = [&json_data, &first_element, &indent_count, &indent] (std::string const & name, double value) {
-		if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.set_floating_point: " << name << " : " << value << std::endl;
-		if (!first_element) json_data << ",";
- 		json_data << "\n";
-		for (int i = indent_count; i != 0; --i) json_data << indent; 
-		if (name.empty()) json_data << value;
-		else json_data << "\"" << name << "\": " << value;
-		first_element = false;
-	};
+template<typename T>
+inline void map_json_to_struct(T & result_struct, std::string_view json_data) {
+	detail::Input input(json_data.data(), json_data.size());
+
+	auto previous_first = detail::F_source::first;
+	auto previous_last = detail::F_source::last;
+	detail::F_source::first = json_data.data();
+	detail::F_source::last = json_data.data() + json_data.size();
+	try {
+		detail::map_json_to_struct(result_struct, input);
+	} catch (...) {
+		detail::F_source::first = previous_first;
+		detail::F_source::last = previous_last;
+		throw;
+	}
+	detail::F_source::first = previous_first;
+	detail::F_source::last = previous_last;
+}
 
-	detail::F_iterate_over::set_string = [&json_data, &first_element, &indent_count, &indent] (std::string const & name, std::string value) {
-		if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.set_string: " << name << " : " << value << std::endl;
-		if (!first_element) json_data << ",";
- 		json_data << "\n";
-		for (int i = indent_count; i != 0; --i) json_data << indent; 
-		if (name.empty()) json_data << "\"" << value << "\"";
-		else json_data << "\"" << name << "\": \"" << value << "\"";
-		first_element = false;
-	};
+template<typename T>
+inline void map_json_to_struct(T & result_struct, std::string_view json_data, std::pmr::memory_resource * resource) {
+	auto previous_resource = detail::F_memory_resource::resource;
+	detail::F_memory_resource::resource = resource;
+	try {
+		map_json_to_struct(result_struct, json_data);
+	} catch (...) {
+		detail::F_memory_resource::resource = previous_resource;
+		throw;
+	}
+	detail::F_memory_resource::resource = previous_resource;
+}
 
-	detail::F_iterate_over::start_struct = [&json_data, &first_element, &indent_count, &indent] (std::string const & name) {
-		if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.start_struct: " << name << std::endl;
-		if (!first_element) json_data << ",";
- 		if (indent_count != 0) json_data << "\n";
-		for (int i = indent_count; i != 0; --i) json_data << indent; 
-		first_element = true;
-		if (name.empty()) json_data << "{";
-		else json_data << "\"" << name << "\": {";
-		++indent_count;
-	};
+template<typename T>
+inline void map_json_to_struct(T & result_struct, std::basic_istream<char> & json_data, std::pmr::memory_resource * resource) {
+	auto previous_resource = detail::F_memory_resource::resource;
+	detail::F_memory_resource::resource = resource;
+	try {
+		map_json_to_struct(result_struct, json_data);
+	} catch (...) {
+		detail::F_memory_resource::resource = previous_resource;
+		throw;
+	}
+	detail::F_memory_resource::resource = previous_resource;
+}
 
-	detail::F_iterate_over::end_struct = [&json_data, &first_element, &indent_count, &indent] () {
-		if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.end_struct:" << std::endl;
-		--indent_count;
-		json_data << "\n";
-		for (int i = indent_count; i != 0; --i) json_data << indent; 
-		json_data << "}";
-		first_element = false;
-	};
+struct Reuse {};
 
-	detail::F_iterate_over::start_array = [&json_data, &first_element, &indent_count, &indent] (std::string const & name) {
-		if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.start_array: " << name << std::endl;
-		if (!first_element) json_data << ",";
- 		json_data << "\n";
-		for (int i = indent_count; i != 0; --i) json_data << indent; 
-		first_element = true;
-		if (name.empty()) json_data << "[";
-		else json_data << "\"" << name << "\": [";
-		++indent_count;
-	};
+template<typename T>
+inline void map_json_to_struct(T & result_struct, std::basic_istream<char> & json_data, const Reuse &) {
+	detail::F_reuse::enabled = true;
+	try {
+		map_json_to_struct(result_struct, json_data);
+	} catch (...) {
+		detail::F_reuse::enabled = false;
+		throw;
+	}
+	detail::F_reuse::enabled = false;
+}
 
-	detail::F_iterate_over::end_array = [&json_data, &first_element, &indent_count, &indent] () {
-		if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.end_array:" << std::endl;
-		--indent_count;
-		json_data << "\n";
-		for (int i = indent_count; i != 0; --i) json_data << indent; 
-		json_data << "]";
-		first_element = false;
-	};
+template<typename T, typename Callback>
+inline std::size_t map_json_stream(std::basic_istream<char> & json_data, Callback callback) {
+	detail::Input input(&json_data);
+	T result_struct{};
+
+	auto previous_reuse = detail::F_reuse::enabled;
+	detail::F_reuse::enabled = true;
+	try {
+		auto count = detail::map_json_stream(input, result_struct, [&] {return detail::deliver(callback, result_struct);});
+		detail::F_reuse::enabled = previous_reuse;
+		return count;
+	} catch (...) {
+		detail::F_reuse::enabled = previous_reuse;
+		throw;
+	}
+}
 
+template<typename T, typename Callback>
+inline std::size_t map_json_stream(std::string_view json_data, Callback callback) {
+	detail::Input input(json_data.data(), json_data.size());
+	T result_struct{};
+
+	auto previous_reuse = detail::F_reuse::enabled;
+	auto previous_first = detail::F_source::first;
+	auto previous_last = detail::F_source::last;
+	detail::F_reuse::enabled = true;
+	detail::F_source::first = json_data.data();
+	detail::F_source::last = json_data.data() + json_data.size();
+	try {
+		auto count = detail::map_json_stream(input, result_struct, [&] {return detail::deliver(callback, result_struct);});
+		detail::F_reuse::enabled = previous_reuse;
+		detail::F_source::first = previous_first;
+		detail::F_source::last = previous_last;
+		return count;
+	} catch (...) {
+		detail::F_reuse::enabled = previous_reuse;
+		detail::F_source::first = previous_first;
+		detail::F_source::last = previous_last;
+		throw;
+	}
+}
+
+template<typename T, typename Callback>
+inline std::size_t map_json_array(std::basic_istream<char> & json_data, Callback callback) {
+	detail::Input input(&json_data);
+	T result_struct{};
+
+	auto previous_reuse = detail::F_reuse::enabled;
+	detail::F_reuse::enabled = true;
+	try {
+		auto count = detail::map_json_array(input, result_struct, [&] {return detail::deliver(callback, result_struct);});
+		detail::F_reuse::enabled = previous_reuse;
+		return count;
+	} catch (...) {
+		detail::F_reuse::enabled = previous_reuse;
+		throw;
+	}
+}
+
+template<typename T, typename Callback>
+inline std::size_t map_json_array(std::string_view json_data, Callback callback) {
+	detail::Input input(json_data.data(), json_data.size());
+	T result_struct{};
+
+	auto previous_reuse = detail::F_reuse::enabled;
+	auto previous_first = detail::F_source::first;
+	auto previous_last = detail::F_source::last;
+	detail::F_reuse::enabled = true;
+	detail::F_source::first = json_data.data();
+	detail::F_source::last = json_data.data() + json_data.size();
+	try {
+		auto count = detail::map_json_array(input, result_struct, [&] {return detail::deliver(callback, result_struct);});
+		detail::F_reuse::enabled = previous_reuse;
+		detail::F_source::first = previous_first;
+		detail::F_source::last = previous_last;
+		return count;
+	} catch (...) {
+		detail::F_reuse::enabled = previous_reuse;
+		detail::F_source::first = previous_first;
+		detail::F_source::last = previous_last;
+		throw;
+	}
+}
+
+template<typename T, typename A>
+inline void map_json_array(std::vector<T, A> & result, std::basic_istream<char> & json_data) {
+	detail::Input input(&json_data);
+	T result_struct{};
+
+	result.clear();
+	detail::map_json_array(input, result_struct, [&] {
+		result.push_back(std::move(result_struct));
+		result_struct = T{};
+		return true;
+	});
+}
+
+template<typename T, typename A>
+inline void map_json_array(std::vector<T, A> & result, std::string_view json_data) {
+	detail::Input input(json_data.data(), json_data.size());
+	T result_struct{};
+
+	auto previous_first = detail::F_source::first;
+	auto previous_last = detail::F_source::last;
+	detail::F_source::first = json_data.data();
+	detail::F_source::last = json_data.data() + json_data.size();
+	try {
+		result.clear();
+		detail::map_json_array(input, result_struct, [&] {
+			result.push_back(std::move(result_struct));
+			result_struct = T{};
+			return true;
+		});
+	} catch (...) {
+		detail::F_source::first = previous_first;
+		detail::F_source::last = previous_last;
+		throw;
+	}
+	detail::F_source::first = previous_first;
+	detail::F_source::last = previous_last;
+}
+
+struct IgnoreUnknown {};
+
+template<typename T>
+inline void map_json_to_struct(T & result_struct, std::basic_istream<char> & json_data, const IgnoreUnknown &) {
+	detail::F_ignore_unknown::enabled = true;
+	try {
+		map_json_to_struct(result_struct, json_data);
+	} catch (...) {
+		detail::F_ignore_unknown::enabled = false;
+		throw;
+	}
+	detail::F_ignore_unknown::enabled = false;
+}
+
+template<typename T>
+inline void map_json_to_struct(T & result_struct, std::string_view json_data, const IgnoreUnknown &) {
+	detail::F_ignore_unknown::enabled = true;
+	try {
+		map_json_to_struct(result_struct, json_data);
+	} catch (...) {
+		detail::F_ignore_unknown::enabled = false;
+		throw;
+	}
+	detail::F_ignore_unknown::enabled = false;
+}
+
+template<typename T>
+inline void map_json_to_struct(T & result_struct, std::basic_istream<char> & json_data, const Projection & projection) {
+	projection.install();
+	detail::F_projection::enabled = true;
+	try {
+		map_json_to_struct(result_struct, json_data);
+	} catch (...) {
+		detail::F_projection::enabled = false;
+		projection.uninstall();
+		throw;
+	}
+	detail::F_projection::enabled = false;
+	projection.uninstall();
+}
+
+template<typename T>
+inline void map_json_to_struct(T & result_struct, std::string_view json_data, const Projection & projection) {
+	projection.install();
+	detail::F_projection::enabled = true;
+	try {
+		map_json_to_struct(result_struct, json_data);
+	} catch (...) {
+		detail::F_projection::enabled = false;
+		projection.uninstall();
+		throw;
+	}
+	detail::F_projection::enabled = false;
+	projection.uninstall();
+}
+
+template<typename T>
+inline void map_struct_to_json(const T & source_struct, std::basic_ostream<char> & json_data) {
+	detail::OstreamSink sink(json_data);
+	detail::Writer writer(sink);
+	writer.install();
+	detail::F<T>::iterate_over(source_struct, "");
+}
+
+template<typename T>
+inline void map_struct_to_json(const T & source_struct, std::basic_ostream<char> & json_data, std::string indent) {
+	detail::OstreamSink sink(json_data);
+	detail::Writer writer(sink, std::move(indent));
+	writer.install();
+	detail::F<T>::iterate_over(source_struct, "");
+}
+
+template<typename T>
+inline std::size_t map_struct_to_json(const T & source_struct, char * buffer, std::size_t capacity) {
+	detail::BufferSink sink(buffer, capacity);
+	detail::Writer writer(sink);
+	writer.install();
+	detail::F<T>::iterate_over(source_struct, "");
+	return sink.count;
+}
+
+struct Parallel {
+	unsigned int threads = 0;
+	std::size_t chunk_size = 1024;
+	bool ordered = true;
+};
+
+template<typename T, typename Sink, typename = std::enable_if_t<!std::is_base_of_v<std::basic_ostream<char>, Sink>>>
+inline void map_struct_to_json(const T & source_struct, Sink & sink, const Parallel & parallel) {
+	detail::ThreadPool pool(parallel.threads);
+	detail::Writer writer(sink);
+	writer.install();
+
+	detail::F_iterate_over::pool = &pool;
+	detail::F_iterate_over::chunk_size = parallel.chunk_size;
+	try {
+		detail::F<T>::iterate_over(source_struct, "");
+	} catch (...) {
+		detail::F_iterate_over::pool = nullptr;
+		throw;
+	}
+	detail::F_iterate_over::pool = nullptr;
+}
+
+template<typename T>
+inline void map_struct_to_json(const T & source_struct, std::basic_ostream<char> & json_data, const Parallel & parallel) {
+	detail::OstreamSink sink(json_data);
+	map_struct_to_json(source_struct, sink, parallel);
+}
+
+template<typename T, typename Callback>
+inline std::size_t map_json_stream(std::string_view json_data, Callback callback, const Parallel & parallel) {
+	detail::F<T>::register_types();
+
+	auto records_count = std::max<std::size_t>(parallel.chunk_size, 1);
+	std::size_t position = 0;
+	std::atomic<bool> stopped = false;
+	std::atomic<std::size_t> count = 0;
+	detail::ThreadPool pool(parallel.threads);
+
+	if (parallel.ordered) {
+		std::deque<std::future<std::vector<T>>> results;
+		auto submit = [&] {
+			results.push_back(pool.submit([json_data, records = detail::next_records(json_data, position, records_count)] {
+				std::vector<T> mapped;
+				T result_struct{};
+				detail::map_json_records(json_data, records, result_struct, [&] {
+					mapped.push_back(std::move(result_struct));
+					result_struct = T{};
+					return true;
+				});
+				return mapped;
+			}));
+		};
+
+		while (position < json_data.size() && results.size() < 2 * pool.size()) submit();
+		while (!results.empty() && !stopped) {
+			auto mapped = results.front().get();
+			results.pop_front();
+			for (auto & result_struct : mapped) {
+				++count;
+				if (!detail::deliver(callback, result_struct)) {
+					stopped = true;
+					break;
+				}
+			}
+			if (position < json_data.size()) submit();
+		}
+		return count;
+	}
+
+	static_assert(std::is_invocable_v<Callback &, T &>, "struct_mapping::map_json_stream: unordered delivery requires a callback");
+
+	std::vector<std::future<void>> results;
+	while (position < json_data.size()) {
+		results.push_back(pool.submit([&, records = detail::next_records(json_data, position, records_count)] {
+			if (stopped) return;
+			try {
+				T result_struct{};
+				detail::map_json_records(json_data, records, result_struct, [&] {
+					++count;
+					if (!detail::deliver(callback, result_struct)) stopped = true;
+					return !stopped;
+				});
+			} catch (...) {
+				stopped = true;
+				throw;
+			}
+		}));
+	}
+	detail::ThreadPool::wait(results);
+	return count;
+}
+
+template<typename T, typename A>
+inline void map_json_array(std::vector<T, A> & result, std::string_view json_data, const Parallel & parallel) {
+	detail::F<T>::register_types();
+
+	auto ranges = detail::split_json_array(json_data, std::max<std::size_t>(parallel.chunk_size, 1));
+	std::vector<std::vector<T>> pieces(ranges.size());
+	detail::ThreadPool pool(parallel.threads);
+
+	std::vector<std::future<void>> results;
+	for (std::size_t i = 0; i < ranges.size(); ++i) {
+		results.push_back(pool.submit([json_data, elements = ranges[i], &piece = pieces[i]] {
+			T result_struct{};
+			detail::map_json_elements(json_data, elements, result_struct, [&] {
+				piece.push_back(std::move(result_struct));
+				result_struct = T{};
+				return true;
+			});
+		}));
+	}
+	detail::ThreadPool::wait(results);
+
+	std::size_t size = 0;
+	for (auto & piece : pieces) size += piece.size();
+
+	result.clear();
+	result.reserve(size);
+	for (auto & piece : pieces) {
+		for (auto & element : piece) result.push_back(std::move(element));
+	}
+}
+
+template<typename T>
+inline std::size_t json_size(const T & source_struct) {
+	detail::CountingSink sink;
+	detail::Writer writer(sink);
+	writer.install();
 	detail::F<T>::iterate_over(source_struct, "");
+	return sink.count;
 }
 
 }
@@ -20,7 +20,8 @@ public:
 		static_assert(!std::is_same_v<M, bool> || std::is_same_v<T, bool>, "bad option (Default): type error, expected bool");
 		static_assert(!detail::is_integer_v<M> || detail::is_integer_v<T>, "bad option (Default): type error, expected integer");
 		static_assert(!std::is_floating_point_v<M> || detail::is_integer_or_floating_point_v<T>, "bad option (Default): type error, expected integer or floating point");
-		static_assert(!std::is_same_v<M, std::string> || std::is_same_v<T, std::string> || std::is_same_v<T, const char *>, "bad option (Default): type error, expected string");
+		static_assert(!detail::is_string_v<M> || detail::is_string_v<T> || std::is_same_v<T, const char *>, "bad option (Default): type error, expected string");
+		static_assert(!detail::is_string_view_v<M> || detail::is_string_view_v<T> || std::is_same_v<T, const char *>, "bad option (Default): type error, expected string literal or string_view");
 		static_assert(!std::is_enum_v<M> || std::is_enum_v<T>, "bad option (Default): type error, expected enumeration");
 		static_assert(detail::is_integral_or_floating_point_or_string_v<M> || std::is_same_v<std::decay_t<M>, std::decay_t<T>>, "bad option (Default): type error");
 
@@ -10,12 +10,12 @@ class NotEmpty {
 public:
 	template<typename M>
 	void check_option() const {
-		static_assert(std::is_same_v<std::string, M> || detail::is_container_like_v<M>, "bad option (NotEmpty): option can only be applied to types: string, sequence container");
+		static_assert(detail::is_string_v<M> || detail::is_string_view_v<M> || detail::is_container_like_v<M>, "bad option (NotEmpty): option can only be applied to types: string, sequence container");
 	}
 
 	template<typename V>
 	static void check_result(const V & value, const std::string & name) {
-		if constexpr (std::is_same_v<std::string, V> || detail::is_container_like_v<V>) {
+		if constexpr (detail::is_string_v<V> || detail::is_string_view_v<V> || detail::is_container_like_v<V>) {
 			if (value.empty()) throw StructMappingException("value for '" + name + "' cannot be empty");
 		}
 	}
@@ -0,0 +1,39 @@
+#ifndef STRUCT_MAPPING_OPTIONS_OPTION_RESERVE_H
+#define STRUCT_MAPPING_OPTIONS_OPTION_RESERVE_H
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+
+#include "struct_mapping/f.h"
+#include "struct_mapping/exception.h"
+
+namespace struct_mapping {
+
+template<typename T = std::size_t>
+class Reserve {
+public:
+	Reserve(T size_)
+		:	size(size_) {}
+
+	template<typename M>
+	void check_option(const std::string & name) const {
+		static_assert(detail::is_integer_v<T>, "bad option (Reserve): type error, expected integer");
+		static_assert(detail::is_container_like_v<M>, "bad option (Reserve): option can only be applied to types: sequence container, associative container");
+
+		if constexpr (std::is_signed_v<T>) {
+			if (size < 0) throw StructMappingException("bad option (Reserve) for '" + name + "': size = " + std::to_string(size) + " is negative");
+		}
+	}
+
+	std::size_t get_value() const {
+		return static_cast<std::size_t>(size);
+	}
+
+private:
+	T size;
+};
+
+}
+
+#endif
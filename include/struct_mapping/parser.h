@@ -1,13 +1,23 @@
 #ifndef STRUCT_MAPPING_PARSER_H
 #define STRUCT_MAPPING_PARSER_H
 
+#include <cstddef>
 #include <istream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 #include "exception.h"
+#include "input.h"
 
 namespace struct_mapping::detail {
 
+enum class ValueAction {
+	Map,
+	Capture,
+	Skip,
+};
+
 template<
 	typename SetBool,
 	typename SetFloatingPoint,
@@ -17,7 +27,9 @@ template<
 	typename StartStruct,
 	typename EndStruct,
 	typename StartArray,
-	typename EndArray>
+	typename EndArray,
+	typename GetValueAction = std::nullptr_t,
+	typename SetRaw = std::nullptr_t>
 class Parser {
 public:
 	using stream_type = std::basic_istream<char>;
@@ -31,7 +43,9 @@ public:
 		StartStruct start_struct_,
 		EndStruct end_struct_,
 		StartArray start_array_,
-		EndArray end_array_)
+		EndArray end_array_,
+		GetValueAction get_value_action_ = nullptr,
+		SetRaw set_raw_ = nullptr)
 		:	set_bool(set_bool_),
 			set_integral(set_integral_),
 			set_floating_point(set_floating_point_),
@@ -40,17 +54,30 @@ public:
 			start_struct(start_struct_),
 			end_struct(end_struct_),
 			start_array(start_array_),
-			end_array(end_array_) {
+			end_array(end_array_),
+			get_value_action(get_value_action_),
+			set_raw(set_raw_) {
 	}
 
 	void parse(stream_type * data_) {
-		data = data_;
+		Input input_(data_);
+		parse(input_);
+	}
+
+	void parse(Input & input_) {
+		input = &input_;
 
 		wait("{");
 		start_struct("");
 		parse_struct();
 	}
 
+	void parse_value(Input & input_, const std::string & name) {
+		input = &input_;
+
+		parse_value(name, wait("\"{[tf-0123456789n"));
+	}
+
 private:
 	SetBool set_bool;
 	SetIntegral set_integral;
@@ -61,42 +88,42 @@ private:
 	EndStruct end_struct;
 	StartArray start_array;
 	EndArray end_array;
-
-	stream_type * data;
-	size_t line_number = 1;
-	char wait_char = '\0';
-
-	stream_type & get_next_char(char & ch) {
-		if (wait_char != '\0') {
-			ch = wait_char;
-			wait_char = '\0';
-		} else {
-			data->get(ch);
+	GetValueAction get_value_action;
+	SetRaw set_raw;
+
+	Input * input = nullptr;
+	std::string string_name;
+	std::string string_value;
+
+	bool parse_raw(const std::string & name, char start_ch) {
+		if constexpr (!std::is_same_v<GetValueAction, std::nullptr_t>) {
+			switch (get_value_action(name)) {
+			case ValueAction::Capture: set_raw(name, input->skip_value(start_ch, string_value, true)); return true;
+			case ValueAction::Skip: input->skip_value(start_ch, string_value, false); return true;
+			case ValueAction::Map: break;
+			}
 		}
 
-		return *data;
+		return false;
 	}
 
-	std::string get_string() {
-		std::string result;
-		char next_ch;
-		while (data->get(next_ch)) {
-			if (next_ch != '\"') {
-				result += next_ch;
-			} else if (next_ch == '\"') {
-				return result;
-			}
+	void parse_string(const std::string & name) {
+		if constexpr (std::is_invocable_v<SetString, const std::string &, std::string_view>) {
+			set_string(name, input->get_string_view(string_value));
+		} else {
+			input->get_string(string_value);
+			set_string(name, string_value);
 		}
-
-		throw StructMappingException("parser: unexpected end of data");
 	}
 
-	bool is_empty_char(char ch) const {
-		return ch == ' ' || ch == '\t' || ch == '\r';
-	}
+	void parse_array_start(const std::string & name) {
+		if constexpr (std::is_same_v<std::invoke_result_t<StartArray, const std::string &>, bool>) {
+			if (start_array(name)) return;
+		} else {
+			start_array(name);
+		}
 
-	bool is_new_line_char(char ch) const {
-		return ch == '\n';
+		parse_array();
 	}
 
 	void parse_array() {
@@ -123,13 +150,17 @@ private:
 	}
 
 	void parse_array_value(char start_ch) {
-		std::string name("");
+		parse_value(std::string(), start_ch);
+	}
+
+	void parse_value(const std::string & name, char start_ch) {
+		if (parse_raw(name, start_ch)) return;
+
 		if (start_ch == '{') {
 			start_struct(name);
 			parse_struct();
 		} else if (start_ch == '[') {
-			start_array(name);
-			parse_array();
+			parse_array_start(name);
 		} else if (start_ch == 't') {
 			wait("r");
 			wait("u");
@@ -147,7 +178,7 @@ private:
 			wait("l");
 			set_null(name);
 		} else if (start_ch == '\"') {
-			set_string(name, get_string());
+			parse_string(name);
 		} else {
 			set_number(name, start_ch);
 		}
@@ -177,85 +208,37 @@ private:
 	}
 
 	void parse_struct_value() {
-		auto name = get_string();
+		auto & name = string_name;
+		input->get_string(name);
 		wait(":");
 
-		char value_start_ch = wait("\"{[tf-0123456789n");
-
-		if (value_start_ch == '{') {
-			start_struct(name);
-			parse_struct();
-		} else if (value_start_ch == '[') {
-			start_array(name);
-			parse_array();
-		} else if (value_start_ch == 't') {
-			wait("r");
-			wait("u");
-			wait("e");
-			set_bool(name, true);
-		} else if (value_start_ch == 'f') {
-			wait("a");
-			wait("l");
-			wait("s");
-			wait("e");
-			set_bool(name, false);
-		} else if (value_start_ch == 'n') {
-			wait("u");
-			wait("l");
-			wait("l");
-			set_null(name);
-		} else if (value_start_ch == '\"') {
-			set_string(name, get_string());
-		} else {
-			set_number(name, value_start_ch);
-		}
+		parse_value(name, wait("\"{[tf-0123456789n"));
 	}
 
-	void set_number(std::string & name, char start_ch) {
-		std::string value{start_ch};
-		char next_ch;
-		bool is_floating_point_number = false;
+	void set_number(const std::string & name, char start_ch) {
+		auto value = input->get_number(start_ch);
+		bool is_floating_point_number = detail::is_floating_point_number(value);
+		bool ok;
+		long long integral_value = 0;
+		double floating_point_value = 0;
 
-		for (;;) {
-			next_ch = wait("}],.0123456789eE+-");
-			if (next_ch == '.') is_floating_point_number = true;
-
-			if (next_ch == ',' || next_ch == '}' || next_ch == ']') {
-				wait_char = next_ch;
-				try {
-					if (is_floating_point_number) set_floating_point(name, std::stod(value));
-					else set_integral(name, std::stoll(value));
-				} catch (std::invalid_argument&) {
-					throw StructMappingException(std::string("parser: bad number [") + value + std::string("] at line ") + std::to_string(line_number));
-				} catch (std::out_of_range&) {
-					throw StructMappingException(std::string("parser: bad number [") + value + std::string("] at line ") + std::to_string(line_number));
-				}
-				return;
-			}
+		if (is_floating_point_number) ok = number_from_chars(value, floating_point_value);
+		else ok = number_from_chars(value, integral_value);
 
-			value += next_ch;
-		}
-	}
+		std::string bad_value;
+		if (!ok) bad_value = value;
 
-	char wait(char const * characters_) {
-		char test_ch;
-		while (get_next_char(test_ch)) {
-			char const * characters = characters_;
-			while (*characters) {
-				if (test_ch == *characters) {
-					return test_ch;
-				}
-				++characters;
-			}
- 			
-			if (is_new_line_char(test_ch)) {
-				++line_number;
-			} else if (!is_empty_char(test_ch)) {
-				throw StructMappingException(std::string("parser: unexpected character '") + std::string(1, test_ch) + std::string("' at line ") + std::to_string(line_number));
-			}
-		}
+		wait("}],");
+		input->unget();
+
+		if (!ok) throw StructMappingException(std::string("parser: bad number [") + bad_value + std::string("] at line ") + std::to_string(input->line_number));
+
+		if (is_floating_point_number) set_floating_point(name, floating_point_value);
+		else set_integral(name, integral_value);
+	}
 
-		throw StructMappingException("parser: unexpected end of data");
+	char wait(char const * characters) {
+		return input->wait(characters);
 	}
 };
 
@@ -0,0 +1,158 @@
+#ifndef STRUCT_MAPPING_PIPELINE_H
+#define STRUCT_MAPPING_PIPELINE_H
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <istream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "f_struct.h"
+#include "mapper.h"
+#include "thread_pool.h"
+
+namespace struct_mapping {
+
+struct Pipeline {
+	unsigned int threads = 0;
+	std::size_t buffer_size = 1048576;
+	std::size_t queue_size = 4;
+	bool ordered = true;
+	std::function<std::string (std::string_view)> transform = nullptr;
+};
+
+namespace detail {
+
+template<typename T>
+struct MappedRecords {
+	std::unique_ptr<std::string> records;
+	std::vector<T> values;
+};
+
+inline void read_blocks(std::basic_istream<char> & json_data, std::size_t buffer_size, BoundedQueue<std::string> & blocks) {
+	for (;;) {
+		std::string block(buffer_size, '\0');
+		json_data.read(block.data(), static_cast<std::streamsize>(block.size()));
+		block.resize(static_cast<std::size_t>(json_data.gcount()));
+		if (block.empty() || !blocks.push(std::move(block))) return;
+	}
+}
+
+template<typename T, typename Submit>
+inline void split_blocks(const Pipeline & pipeline, BoundedQueue<std::string> & blocks, BoundedQueue<std::future<MappedRecords<T>>> & results, Submit submit) {
+	auto records = std::make_unique<std::string>();
+	for (std::string block; blocks.pop(block);) {
+		if (pipeline.transform) records->append(pipeline.transform(block));
+		else if (records->empty()) records->swap(block);
+		else records->append(block);
+
+		auto end = records->rfind('\n');
+		if (end == std::string::npos) continue;
+
+		auto rest = std::make_unique<std::string>(*records, end + 1);
+		records->resize(end + 1);
+		if (!results.push(submit(std::move(records)))) return;
+		records = std::move(rest);
+	}
+
+	if (!records->empty()) results.push(submit(std::move(records)));
+}
+
+}
+
+template<typename T, typename Callback>
+inline std::size_t map_json_stream(std::basic_istream<char> & json_data, Callback callback, const Pipeline & pipeline) {
+	static_assert(std::is_invocable_v<Callback &, T &>, "struct_mapping::map_json_stream: pipeline requires a callback");
+
+	detail::F<T>::register_types();
+
+	std::atomic<bool> stopped = false;
+	std::atomic<std::size_t> count = 0;
+	detail::BoundedQueue<std::string> blocks(pipeline.queue_size);
+	detail::BoundedQueue<std::future<detail::MappedRecords<T>>> results(pipeline.queue_size);
+	detail::ThreadPool pool(pipeline.threads);
+
+	auto submit = [&] (std::unique_ptr<std::string> records) {
+		return pool.submit([&, records = std::move(records)] () mutable {
+			detail::MappedRecords<T> mapped;
+			if (stopped) return mapped;
+
+			T result_struct{};
+			if (pipeline.ordered) {
+				detail::map_json_records(*records, *records, result_struct, [&] {
+					mapped.values.push_back(std::move(result_struct));
+					result_struct = T{};
+					return true;
+				});
+				mapped.records = std::move(records);
+			} else {
+				detail::map_json_records(*records, *records, result_struct, [&] {
+					++count;
+					if (!detail::deliver(callback, result_struct)) stopped = true;
+					return !stopped;
+				});
+			}
+			return mapped;
+		});
+	};
+
+	std::exception_ptr reader_exception;
+	std::thread reader([&] {
+		try {
+			detail::read_blocks(json_data, pipeline.buffer_size, blocks);
+		} catch (...) {
+			reader_exception = std::current_exception();
+		}
+		blocks.close();
+	});
+
+	std::exception_ptr splitter_exception;
+	std::thread splitter([&] {
+		try {
+			detail::split_blocks<T>(pipeline, blocks, results, submit);
+		} catch (...) {
+			splitter_exception = std::current_exception();
+		}
+		blocks.close();
+		results.close();
+	});
+
+	std::exception_ptr exception;
+	try {
+		for (std::future<detail::MappedRecords<T>> result; !stopped && results.pop(result);) {
+			auto mapped = result.get();
+			for (auto & result_struct : mapped.values) {
+				++count;
+				if (!detail::deliver(callback, result_struct)) {
+					stopped = true;
+					break;
+				}
+			}
+		}
+	} catch (...) {
+		exception = std::current_exception();
+		stopped = true;
+	}
+
+	results.close();
+	blocks.close();
+	splitter.join();
+	reader.join();
+
+	if (exception) std::rethrow_exception(exception);
+	if (splitter_exception) std::rethrow_exception(splitter_exception);
+	if (reader_exception) std::rethrow_exception(reader_exception);
+	return count;
+}
+
+}
+
+#endif
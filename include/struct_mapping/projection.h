@@ -0,0 +1,38 @@
+#ifndef STRUCT_MAPPING_PROJECTION_H
+#define STRUCT_MAPPING_PROJECTION_H
+
+#include <string>
+#include <vector>
+
+#include "f_struct.h"
+
+namespace struct_mapping {
+
+class Projection {
+public:
+	template<typename T>
+	Projection & select(const std::vector<std::string> & names) {
+		entries.push_back(Entry{detail::F<T>::projection_mask(names), [] (const std::vector<bool> * mask) {detail::F<T>::projection = mask;}});
+		return *this;
+	}
+
+	void install() const {
+		for (auto & entry : entries) entry.set(&entry.mask);
+	}
+
+	void uninstall() const {
+		for (auto & entry : entries) entry.set(nullptr);
+	}
+
+private:
+	struct Entry {
+		std::vector<bool> mask;
+		void (*set)(const std::vector<bool> *);
+	};
+
+	std::vector<Entry> entries;
+};
+
+}
+
+#endif
@@ -0,0 +1,443 @@
+#ifndef STRUCT_MAPPING_PUSH_PARSER_H
+#define STRUCT_MAPPING_PUSH_PARSER_H
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "debug.h"
+#include "exception.h"
+#include "f.h"
+#include "f_struct.h"
+#include "f_array.h"
+#include "f_map.h"
+#include "input.h"
+#include "parser.h"
+
+namespace struct_mapping {
+
+namespace detail {
+
+template<typename Handler>
+class PushParser {
+public:
+	explicit PushParser(Handler & handler_)
+		:	handler(handler_) {}
+
+	bool feed(std::string_view chunk) {
+		const char * current = chunk.data();
+		const char * last = chunk.data() + chunk.size();
+
+		while (current != last) {
+			switch (state) {
+			case State::Start: current = parse_start(current); break;
+			case State::Key: current = parse_key(current); break;
+			case State::Colon: current = parse_colon(current); break;
+			case State::Value: current = parse_value(current); break;
+			case State::AfterValue: current = parse_after_value(current); break;
+			case State::String: current = parse_string(current, last); break;
+			case State::Number: current = parse_number(current, last); break;
+			case State::Literal: current = parse_literal(current); break;
+			case State::Raw: current = parse_raw(current, last); break;
+			case State::Done: current = parse_done(current); break;
+			}
+		}
+
+		return done();
+	}
+
+	bool done() const {
+		return state == State::Done;
+	}
+
+	size_t line_number = 1;
+
+private:
+	enum class State {
+		Start,
+		Key,
+		Colon,
+		Value,
+		AfterValue,
+		String,
+		Number,
+		Literal,
+		Raw,
+		Done,
+	};
+
+	Handler & handler;
+	State state = State::Start;
+	std::vector<char> stack;
+	std::string name;
+	std::string token;
+	std::string decoded;
+	bool first = false;
+	bool string_is_name = false;
+	bool escaped = false;
+	bool has_escape = false;
+	const char * literal = nullptr;
+	char literal_start = 0;
+	int raw_depth = 0;
+	bool raw_in_string = false;
+	bool raw_capture = false;
+	char raw_start = 0;
+
+	static bool is_space(char ch) {
+		return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+	}
+
+	const char * skip_space(const char * current) {
+		if (*current == '\n') ++line_number;
+		return current + 1;
+	}
+
+	[[noreturn]] void throw_unexpected(char ch) const {
+		throw StructMappingException(std::string("parser: unexpected character '") + std::string(1, ch) + std::string("' at line ") + std::to_string(line_number));
+	}
+
+	const std::string & value_name() const {
+		static const std::string EMPTY;
+		return stack.back() == '{' ? name : EMPTY;
+	}
+
+	const char * parse_start(const char * current) {
+		if (is_space(*current)) return skip_space(current);
+		if (*current != '{') throw_unexpected(*current);
+
+		handler.start_struct("");
+		stack.push_back('{');
+		state = State::Key;
+		first = true;
+		return current + 1;
+	}
+
+	const char * parse_key(const char * current) {
+		if (is_space(*current)) return skip_space(current);
+
+		if (*current == '\"') {
+			begin_string(true);
+		} else if (*current == '}' && first) {
+			end_container();
+		} else {
+			throw_unexpected(*current);
+		}
+		return current + 1;
+	}
+
+	const char * parse_colon(const char * current) {
+		if (is_space(*current)) return skip_space(current);
+		if (*current != ':') throw_unexpected(*current);
+
+		state = State::Value;
+		first = false;
+		return current + 1;
+	}
+
+	const char * parse_value(const char * current) {
+		if (is_space(*current)) return skip_space(current);
+
+		char ch = *current;
+		if (ch == ']' && first) {
+			end_container();
+			return current + 1;
+		}
+
+		auto & value_name_ = value_name();
+		if (auto action = handler.value_action(value_name_); action != ValueAction::Map) {
+			if (std::strchr("\"{[tf-0123456789n", ch) == nullptr) throw_unexpected(ch);
+			begin_raw(ch, action == ValueAction::Capture);
+			return current + 1;
+		}
+
+		if (ch == '{') {
+			handler.start_struct(value_name_);
+			stack.push_back('{');
+			state = State::Key;
+			first = true;
+		} else if (ch == '[') {
+			handler.start_array(value_name_);
+			stack.push_back('[');
+			state = State::Value;
+			first = true;
+		} else if (ch == '\"') {
+			begin_string(false);
+		} else if (ch == 't') {
+			begin_literal(ch, "rue");
+		} else if (ch == 'f') {
+			begin_literal(ch, "alse");
+		} else if (ch == 'n') {
+			begin_literal(ch, "ull");
+		} else if (ch == '-' || (ch >= '0' && ch <= '9')) {
+			token.assign(1, ch);
+			state = State::Number;
+		} else {
+			throw_unexpected(ch);
+		}
+		return current + 1;
+	}
+
+	const char * parse_after_value(const char * current) {
+		if (is_space(*current)) return skip_space(current);
+
+		char ch = *current;
+		if (ch == ',') {
+			state = stack.back() == '{' ? State::Key : State::Value;
+			first = false;
+		} else if ((ch == '}' && stack.back() == '{') || (ch == ']' && stack.back() == '[')) {
+			end_container();
+		} else {
+			throw_unexpected(ch);
+		}
+		return current + 1;
+	}
+
+	const char * parse_done(const char * current) {
+		if (!is_space(*current)) throw_unexpected(*current);
+		return skip_space(current);
+	}
+
+	void begin_string(bool is_name) {
+		token.clear();
+		string_is_name = is_name;
+		escaped = false;
+		has_escape = false;
+		state = State::String;
+	}
+
+	const char * parse_string(const char * current, const char * last) {
+		const char * start = current;
+		while (current != last) {
+			if (escaped) {
+				escaped = false;
+				++current;
+				continue;
+			}
+
+			auto quote = find(current, last, '\"');
+			auto backslash = find(current, quote, '\\');
+			if (backslash != quote) {
+				escaped = true;
+				has_escape = true;
+				current = backslash + 1;
+				continue;
+			}
+
+			current = quote;
+			break;
+		}
+
+		token.append(start, current);
+		if (current == last) return current;
+
+		end_string();
+		return current + 1;
+	}
+
+	void end_string() {
+		std::string_view value = token;
+		if (has_escape) {
+			token.push_back('\"');
+			Input input(token.data(), token.size());
+			input.get_string(decoded);
+			value = decoded;
+		}
+
+		if (string_is_name) {
+			name.assign(value.data(), value.size());
+			state = State::Colon;
+		} else {
+			handler.set_string(value_name(), value);
+			state = State::AfterValue;
+		}
+	}
+
+	const char * parse_number(const char * current, const char * last) {
+		const char * start = current;
+		while (current != last && (std::strchr("0123456789+-.eE", *current) != nullptr)) ++current;
+		token.append(start, current);
+		if (current == last) return current;
+
+		bool ok;
+		if (is_floating_point_number(token)) {
+			double value = 0;
+			ok = number_from_chars(token, value);
+			if (ok) handler.set_floating_point(value_name(), value);
+		} else {
+			long long value = 0;
+			ok = number_from_chars(token, value);
+			if (ok) handler.set_integral(value_name(), value);
+		}
+
+		if (!ok) throw StructMappingException(std::string("parser: bad number [") + token + std::string("] at line ") + std::to_string(line_number));
+
+		state = State::AfterValue;
+		return current;
+	}
+
+	void begin_literal(char ch, const char * rest) {
+		literal_start = ch;
+		literal = rest;
+		state = State::Literal;
+	}
+
+	const char * parse_literal(const char * current) {
+		if (*current != *literal) throw_unexpected(*current);
+
+		if (*++literal == '\0') {
+			if (literal_start == 'n') handler.set_null(value_name());
+			else handler.set_bool(value_name(), literal_start == 't');
+			state = State::AfterValue;
+		}
+		return current + 1;
+	}
+
+	void begin_raw(char ch, bool capture) {
+		raw_start = ch;
+		raw_capture = capture;
+		raw_depth = (ch == '{' || ch == '[') ? 1 : 0;
+		raw_in_string = ch == '\"';
+		escaped = false;
+		token.assign(1, ch);
+		state = State::Raw;
+	}
+
+	const char * parse_raw(const char * current, const char * last) {
+		const char * start = current;
+		bool complete = false;
+
+		if (raw_depth == 0 && !raw_in_string && raw_start != '\"') {
+			while (current != last && std::strchr(",}] \t\r\n", *current) == nullptr) ++current;
+			complete = current != last;
+		} else {
+			for (; current != last && !complete; ++current) {
+				char ch = *current;
+				if (raw_in_string) {
+					if (escaped) escaped = false;
+					else if (ch == '\\') escaped = true;
+					else if (ch == '\"') raw_in_string = false;
+				} else if (ch == '\"') {
+					raw_in_string = true;
+				} else if (ch == '{' || ch == '[') {
+					++raw_depth;
+				} else if (ch == '}' || ch == ']') {
+					--raw_depth;
+				} else if (ch == '\n') {
+					++line_number;
+				}
+				complete = raw_depth == 0 && !raw_in_string;
+			}
+		}
+
+		if (raw_capture) token.append(start, current);
+		if (complete) {
+			if (raw_capture) handler.set_raw(value_name(), token);
+			state = State::AfterValue;
+		}
+		return current;
+	}
+
+	void end_container() {
+		if (stack.back() == '{') handler.end_struct();
+		else handler.end_array();
+
+		stack.pop_back();
+		state = stack.empty() ? State::Done : State::AfterValue;
+	}
+
+	static const char * find(const char * first_, const char * last_, char ch) {
+		if (first_ == last_) return last_;
+		auto result = static_cast<const char *>(std::memchr(first_, ch, static_cast<std::size_t>(last_ - first_)));
+		return result == nullptr ? last_ : result;
+	}
+};
+
+}
+
+template<typename T>
+class PushMapper {
+public:
+	explicit PushMapper(T & result_struct_)
+		:	result_struct(result_struct_), parser(*this) {
+		detail::F_reset::reset();
+	}
+
+	PushMapper(const PushMapper &) = delete;
+	PushMapper & operator=(const PushMapper &) = delete;
+
+	bool feed(std::string_view chunk) {
+		return parser.feed(chunk);
+	}
+
+	bool done() const {
+		return parser.done();
+	}
+
+private:
+	friend class detail::PushParser<PushMapper>;
+
+	T & result_struct;
+	detail::PushParser<PushMapper> parser;
+	int struct_level = 0;
+
+	void set_bool(const std::string & name, bool value) {
+		if constexpr (debug) std::cout << "struct_mapping: push_mapper.set_bool: " << name << " : " << std::boolalpha << value << std::endl;
+		detail::F<T>::set_bool(result_struct, name, value);
+	}
+
+	void set_integral(const std::string & name, long long value) {
+		if constexpr (debug) std::cout << "struct_mapping: push_mapper.set_integral: " << name << " : " << value << std::endl;
+		detail::F<T>::set_integral(result_struct, name, value);
+	}
+
+	void set_floating_point(const std::string & name, double value) {
+		if constexpr (debug) std::cout << "struct_mapping: push_mapper.set_floating_point: " << name << " : " << value << std::endl;
+		detail::F<T>::set_floating_point(result_struct, name, value);
+	}
+
+	void set_string(const std::string & name, std::string_view value) {
+		if constexpr (debug) std::cout << "struct_mapping: push_mapper.set_string: " << name << " : " << value << std::endl;
+		detail::F<T>::set_string(result_struct, name, value);
+	}
+
+	void set_null(const std::string & name) {
+		if constexpr (debug) std::cout << "struct_mapping: push_mapper.set_null: " << name << std::endl;
+	}
+
+	void start_struct(const std::string & name) {
+		if constexpr (debug) std::cout << "struct_mapping: push_mapper.start_struct: " << name << std::endl;
+		if (++struct_level == 1) detail::F<T>::init();
+		else detail::F<T>::use(result_struct, name);
+	}
+
+	void end_struct() {
+		if constexpr (debug) std::cout << "struct_mapping: push_mapper.end_struct:" << std::endl;
+		detail::F<T>::release(result_struct);
+		--struct_level;
+	}
+
+	void start_array(const std::string & name) {
+		if constexpr (debug) std::cout << "struct_mapping: push_mapper.start_array: " << name << std::endl;
+		detail::F<T>::use(result_struct, name);
+	}
+
+	void end_array() {
+		if constexpr (debug) std::cout << "struct_mapping: push_mapper.end_array:" << std::endl;
+		detail::F<T>::release(result_struct);
+	}
+
+	detail::ValueAction value_action(const std::string & name) {
+		if (!detail::F_raw_json::registered && !detail::F_ignore_unknown::enabled && !detail::F_projection::enabled) return detail::ValueAction::Map;
+		return detail::F<T>::value_action(result_struct, name);
+	}
+
+	void set_raw(const std::string & name, std::string_view value) {
+		if constexpr (debug) std::cout << "struct_mapping: push_mapper.set_raw: " << name << " : " << value << std::endl;
+		detail::F<T>::set_raw(result_struct, name, value);
+	}
+};
+
+}
+
+#endif
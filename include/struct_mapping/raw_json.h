@@ -0,0 +1,46 @@
+#ifndef STRUCT_MAPPING_RAW_JSON_H
+#define STRUCT_MAPPING_RAW_JSON_H
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace struct_mapping {
+
+class RawJson {
+public:
+	RawJson() = default;
+
+	explicit RawJson(std::string json_)
+		:	json(std::move(json_)) {}
+
+	explicit RawJson(std::string_view json_)
+		:	json(json_) {}
+
+	const std::string & get() const {
+		return json;
+	}
+
+	void set(std::string_view json_) {
+		json.assign(json_.data(), json_.size());
+	}
+
+	bool empty() const {
+		return json.empty();
+	}
+
+	bool operator==(const RawJson & other) const {
+		return json == other.json;
+	}
+
+	bool operator!=(const RawJson & other) const {
+		return json != other.json;
+	}
+
+private:
+	std::string json;
+};
+
+}
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef STRUCT_MAPPING_STREAM_WRITER_H
+#define STRUCT_MAPPING_STREAM_WRITER_H
+
+#include <cstddef>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+#include "f_struct.h"
+#include "f_array.h"
+#include "f_map.h"
+#include "writer.h"
+
+namespace struct_mapping {
+
+namespace detail {
+
+static constexpr std::size_t DEFAULT_FLUSH_THRESHOLD = 65536;
+
+}
+
+enum class StreamFormat {
+	Array,
+	Lines,
+};
+
+template<typename T>
+class StreamWriter {
+public:
+	StreamWriter(
+		std::basic_ostream<char> & json_data_,
+		StreamFormat format_ = StreamFormat::Array,
+		std::size_t flush_threshold_ = detail::DEFAULT_FLUSH_THRESHOLD)
+		:	json_data(json_data_), format(format_), flush_threshold(flush_threshold_) {
+		buffer.reserve(flush_threshold);
+	}
+
+	StreamWriter(const StreamWriter &) = delete;
+	StreamWriter & operator=(const StreamWriter &) = delete;
+
+	~StreamWriter() {
+		if (!finished) {
+			try {
+				finish();
+			} catch (...) {}
+		}
+	}
+
+	void write(const T & source_struct) {
+		if (format == StreamFormat::Array) buffer += (count == 0 ? '[' : ',');
+
+		detail::StringSink sink(buffer);
+		detail::Writer writer(sink);
+		writer.install();
+		detail::F<T>::iterate_over(source_struct, "");
+
+		if (format == StreamFormat::Lines) buffer += '\n';
+		++count;
+
+		if (buffer.size() >= flush_threshold) flush();
+	}
+
+	void flush() {
+		json_data.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		buffer.clear();
+	}
+
+	void finish() {
+		if (format == StreamFormat::Array) buffer += (count == 0 ? "[]" : "]");
+		finished = true;
+		flush();
+	}
+
+	std::size_t size() const {
+		return count;
+	}
+
+private:
+	std::basic_ostream<char> & json_data;
+	StreamFormat format;
+	std::size_t flush_threshold;
+	std::string buffer;
+	std::size_t count = 0;
+	bool finished = false;
+};
+
+template<typename Range>
+inline std::size_t map_range_to_json(
+	Range && range,
+	std::basic_ostream<char> & json_data,
+	StreamFormat format = StreamFormat::Array,
+	std::size_t flush_threshold = detail::DEFAULT_FLUSH_THRESHOLD) {
+	using T = std::decay_t<decltype(*std::begin(range))>;
+
+	StreamWriter<T> writer(json_data, format, flush_threshold);
+	for (auto && source_struct : range) writer.write(source_struct);
+	writer.finish();
+
+	return writer.size();
+}
+
+template<typename T, typename Generator>
+inline std::size_t map_generator_to_json(
+	Generator && generator,
+	std::basic_ostream<char> & json_data,
+	StreamFormat format = StreamFormat::Array,
+	std::size_t flush_threshold = detail::DEFAULT_FLUSH_THRESHOLD) {
+	T source_struct;
+
+	StreamWriter<T> writer(json_data, format, flush_threshold);
+	while (generator(source_struct)) writer.write(source_struct);
+	writer.finish();
+
+	return writer.size();
+}
+
+}
+
+#endif
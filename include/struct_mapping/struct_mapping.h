@@ -3,14 +3,25 @@
 
 #include <string>
 
+#include "batch_mapper.h"
 #include "exception.h"
+#include "extract.h"
 #include "f_struct.h"
+#include "json_handler.h"
+#include "json_view.h"
 #include "member_string.h"
 #include "mapper.h"
 #include "options/option_bounds.h"
 #include "options/option_default.h"
 #include "options/option_not_empty.h"
 #include "options/option_required.h"
+#include "options/option_reserve.h"
+#include "projection.h"
+#include "pipeline.h"
+#include "push_parser.h"
+#include "raw_json.h"
+#include "stream_writer.h"
+#include "tape.h"
 
 namespace struct_mapping {
 
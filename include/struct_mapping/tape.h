@@ -0,0 +1,281 @@
+#ifndef STRUCT_MAPPING_TAPE_H
+#define STRUCT_MAPPING_TAPE_H
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "f.h"
+#include "f_struct.h"
+#include "f_array.h"
+#include "f_map.h"
+#include "input.h"
+#include "mapper.h"
+#include "parser.h"
+#include "writer.h"
+
+namespace struct_mapping {
+
+class Tape {
+public:
+	enum class Type {
+		StartStruct,
+		EndStruct,
+		StartArray,
+		EndArray,
+		Bool,
+		Integral,
+		FloatingPoint,
+		String,
+		Null,
+	};
+
+	struct Token {
+		Type type;
+		std::size_t name_offset;
+		std::size_t name_size;
+		std::size_t string_offset;
+		std::size_t string_size;
+		union {
+			bool bool_value;
+			long long integral_value;
+			double floating_point_value;
+			std::size_t end;
+		};
+	};
+
+	void parse(std::basic_istream<char> & json_data) {
+		detail::Input input(&json_data);
+		parse(input);
+	}
+
+	void parse(std::string_view json_data) {
+		detail::Input input(json_data.data(), json_data.size());
+		parse(input);
+	}
+
+	void clear() {
+		tokens.clear();
+		text.clear();
+		starts.clear();
+	}
+
+	const std::vector<Token> & get_tokens() const {
+		return tokens;
+	}
+
+	std::string_view get_name(const Token & token) const {
+		return std::string_view(text.data() + token.name_offset, token.name_size);
+	}
+
+	std::string_view get_string(const Token & token) const {
+		return std::string_view(text.data() + token.string_offset, token.string_size);
+	}
+
+	const std::string & get_text() const {
+		return text;
+	}
+
+private:
+	std::vector<Token> tokens;
+	std::string text;
+	std::vector<std::size_t> starts;
+
+	Token & add(Type type, const std::string & name) {
+		auto & token = tokens.emplace_back();
+		token.type = type;
+		token.name_offset = text.size();
+		token.name_size = name.size();
+		token.string_offset = 0;
+		token.string_size = 0;
+		token.end = 0;
+		text.append(name);
+		return token;
+	}
+
+	void end(Type type) {
+		tokens[starts.back()].end = tokens.size();
+		starts.pop_back();
+		add(type, std::string());
+	}
+
+	void parse(detail::Input & input) {
+		clear();
+
+		auto set_bool = [this] (const std::string & name, bool value) {
+			add(Type::Bool, name).bool_value = value;
+		};
+
+		auto set_integral = [this] (const std::string & name, long long value) {
+			add(Type::Integral, name).integral_value = value;
+		};
+
+		auto set_floating_point = [this] (const std::string & name, double value) {
+			add(Type::FloatingPoint, name).floating_point_value = value;
+		};
+
+		auto set_string = [this] (const std::string & name, std::string_view value) {
+			auto & token = add(Type::String, name);
+			token.string_offset = text.size();
+			token.string_size = value.size();
+			text.append(value.data(), value.size());
+		};
+
+		auto set_null = [this] (const std::string & name) {
+			add(Type::Null, name);
+		};
+
+		auto start_struct = [this] (const std::string & name) {
+			starts.push_back(tokens.size());
+			add(Type::StartStruct, name);
+		};
+
+		auto end_struct = [this] {
+			end(Type::EndStruct);
+		};
+
+		auto start_array = [this] (const std::string & name) {
+			starts.push_back(tokens.size());
+			add(Type::StartArray, name);
+		};
+
+		auto end_array = [this] {
+			end(Type::EndArray);
+		};
+
+		detail::Parser jp(
+			set_bool,
+			set_integral,
+			set_floating_point,
+			set_string,
+			set_null,
+			start_struct,
+			end_struct,
+			start_array,
+			end_array);
+
+		try {
+			jp.parse(input);
+		} catch (...) {
+			clear();
+			throw;
+		}
+	}
+};
+
+namespace detail {
+
+inline void write_tape_value(const Tape & tape, std::size_t first, std::size_t last, std::string & json) {
+	StringSink sink(json);
+	Writer writer(sink);
+	writer.install();
+
+	auto & tokens = tape.get_tokens();
+	std::string name;
+	for (auto i = first; i <= last; ++i) {
+		auto & token = tokens[i];
+		if (i == first) name.clear();
+		else name.assign(tape.get_name(token));
+
+		switch (token.type) {
+		case Tape::Type::StartStruct: F_iterate_over::start_struct(name); break;
+		case Tape::Type::EndStruct: F_iterate_over::end_struct(); break;
+		case Tape::Type::StartArray: F_iterate_over::start_array(name); break;
+		case Tape::Type::EndArray: F_iterate_over::end_array(); break;
+		case Tape::Type::Bool: F_iterate_over::set_bool(name, token.bool_value); break;
+		case Tape::Type::Integral: F_iterate_over::set_integral(name, token.integral_value); break;
+		case Tape::Type::FloatingPoint: F_iterate_over::set_floating_point(name, token.floating_point_value); break;
+		case Tape::Type::String: F_iterate_over::set_string(name, tape.get_string(token)); break;
+		case Tape::Type::Null: F_iterate_over::set_raw(name, std::string_view()); break;
+		}
+	}
+}
+
+template<typename T>
+inline void map_tape_to_struct(T & result_struct, const Tape & tape) {
+	auto & tokens = tape.get_tokens();
+	if (tokens.empty()) throw StructMappingException("tape is empty");
+
+	F_reset::reset();
+	int struct_level = 0;
+	std::string name;
+	std::string raw;
+
+	for (std::size_t i = 0; i < tokens.size(); ++i) {
+		auto & token = tokens[i];
+		name.assign(tape.get_name(token));
+
+		if (token.type != Tape::Type::EndStruct && token.type != Tape::Type::EndArray && struct_level != 0
+			&& (F_raw_json::registered || F_ignore_unknown::enabled || F_projection::enabled)) {
+			auto last = token.type == Tape::Type::StartStruct || token.type == Tape::Type::StartArray ? token.end : i;
+			switch (F<T>::value_action(result_struct, name)) {
+			case ValueAction::Capture:
+				raw.clear();
+				write_tape_value(tape, i, last, raw);
+				F<T>::set_raw(result_struct, name, raw);
+				i = last;
+				continue;
+			case ValueAction::Skip:
+				i = last;
+				continue;
+			case ValueAction::Map:
+				break;
+			}
+		}
+
+		switch (token.type) {
+		case Tape::Type::StartStruct:
+			if (++struct_level == 1) F<T>::init();
+			else F<T>::use(result_struct, name);
+			break;
+		case Tape::Type::EndStruct:
+			F<T>::release(result_struct);
+			--struct_level;
+			break;
+		case Tape::Type::StartArray: F<T>::use(result_struct, name); break;
+		case Tape::Type::EndArray: F<T>::release(result_struct); break;
+		case Tape::Type::Bool: F<T>::set_bool(result_struct, name, token.bool_value); break;
+		case Tape::Type::Integral: F<T>::set_integral(result_struct, name, token.integral_value); break;
+		case Tape::Type::FloatingPoint: F<T>::set_floating_point(result_struct, name, token.floating_point_value); break;
+		case Tape::Type::String: F<T>::set_string(result_struct, name, tape.get_string(token)); break;
+		case Tape::Type::Null: break;
+		}
+	}
+}
+
+}
+
+template<typename T>
+inline void map_json_to_struct(T & result_struct, const Tape & tape) {
+	auto previous_first = detail::F_source::first;
+	auto previous_last = detail::F_source::last;
+	detail::F_source::first = tape.get_text().data();
+	detail::F_source::last = tape.get_text().data() + tape.get_text().size();
+	try {
+		detail::map_tape_to_struct(result_struct, tape);
+	} catch (...) {
+		detail::F_source::first = previous_first;
+		detail::F_source::last = previous_last;
+		throw;
+	}
+	detail::F_source::first = previous_first;
+	detail::F_source::last = previous_last;
+}
+
+template<typename T>
+inline void map_json_to_struct(T & result_struct, const Tape & tape, const IgnoreUnknown &) {
+	detail::F_ignore_unknown::enabled = true;
+	try {
+		map_json_to_struct(result_struct, tape);
+	} catch (...) {
+		detail::F_ignore_unknown::enabled = false;
+		throw;
+	}
+	detail::F_ignore_unknown::enabled = false;
+}
+
+}
+
+#endif
@@ -0,0 +1,150 @@
+#ifndef STRUCT_MAPPING_THREAD_POOL_H
+#define STRUCT_MAPPING_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace struct_mapping::detail {
+
+template<typename V>
+class BoundedQueue {
+public:
+	explicit BoundedQueue(std::size_t capacity_)
+		:	capacity(capacity_ == 0 ? 1 : capacity_) {}
+
+	BoundedQueue(const BoundedQueue &) = delete;
+	BoundedQueue & operator=(const BoundedQueue &) = delete;
+
+	bool push(V value) {
+		{
+			std::unique_lock lock(mutex);
+			not_full.wait(lock, [this] {return closed || values.size() < capacity;});
+			if (closed) return false;
+			values.push_back(std::move(value));
+		}
+		not_empty.notify_one();
+		return true;
+	}
+
+	bool pop(V & value) {
+		{
+			std::unique_lock lock(mutex);
+			not_empty.wait(lock, [this] {return closed || !values.empty();});
+			if (values.empty()) return false;
+			value = std::move(values.front());
+			values.pop_front();
+		}
+		not_full.notify_one();
+		return true;
+	}
+
+	void close() {
+		{
+			std::lock_guard lock(mutex);
+			closed = true;
+		}
+		not_empty.notify_all();
+		not_full.notify_all();
+	}
+
+private:
+	std::size_t capacity;
+	std::deque<V> values;
+	std::mutex mutex;
+	std::condition_variable not_empty;
+	std::condition_variable not_full;
+	bool closed = false;
+};
+
+class ThreadPool {
+public:
+	explicit ThreadPool(unsigned int threads_count = 0) {
+		if (threads_count == 0) threads_count = std::thread::hardware_concurrency();
+		if (threads_count == 0) threads_count = 1;
+
+		threads.reserve(threads_count);
+		for (unsigned int i = 0; i < threads_count; ++i) {
+			threads.emplace_back([this] {run();});
+		}
+	}
+
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool & operator=(const ThreadPool &) = delete;
+
+	~ThreadPool() {
+		{
+			std::lock_guard lock(mutex);
+			stop = true;
+		}
+		condition.notify_all();
+		for (auto & thread : threads) thread.join();
+	}
+
+	unsigned int size() const {
+		return static_cast<unsigned int>(threads.size());
+	}
+
+	template<typename Task>
+	auto submit(Task && task) {
+		using Result = std::invoke_result_t<std::decay_t<Task>>;
+
+		auto packaged_task = std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(task));
+		auto result = packaged_task->get_future();
+		{
+			std::lock_guard lock(mutex);
+			tasks.emplace_back([packaged_task] {(*packaged_task)();});
+		}
+		condition.notify_one();
+
+		return result;
+	}
+
+	template<typename Result>
+	static void wait(std::vector<std::future<Result>> & results) {
+		std::exception_ptr exception;
+		for (auto & result : results) {
+			try {
+				result.get();
+			} catch (...) {
+				if (!exception) exception = std::current_exception();
+			}
+		}
+
+		if (exception) std::rethrow_exception(exception);
+	}
+
+private:
+	std::vector<std::thread> threads;
+	std::deque<std::function<void()>> tasks;
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool stop = false;
+
+	void run() {
+		for (;;) {
+			std::function<void()> task;
+			{
+				std::unique_lock lock(mutex);
+				condition.wait(lock, [this] {return stop || !tasks.empty();});
+				if (tasks.empty()) return;
+				task = std::move(tasks.front());
+				tasks.pop_front();
+			}
+			task();
+		}
+	}
+};
+
+}
+
+#endif
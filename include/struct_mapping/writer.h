@@ -0,0 +1,282 @@
+#ifndef STRUCT_MAPPING_WRITER_H
+#define STRUCT_MAPPING_WRITER_H
+
+#include <charconv>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "debug.h"
+#include "f.h"
+
+namespace struct_mapping::detail {
+
+static constexpr std::size_t NUMBER_MAX_SIZE = 32;
+
+template<typename, typename = std::void_t<>>
+struct has_writev : std::false_type{};
+
+template<typename T>
+struct has_writev<T, std::void_t<decltype(std::declval<T>().writev(std::declval<const std::string_view *>(), std::size_t()))>> : std::true_type{};
+
+template<typename T>
+constexpr bool has_writev_v = has_writev<T>::value;
+
+template<typename V>
+inline std::size_t format_number(char * out, V value) {
+	std::to_chars_result result;
+	if constexpr (std::is_floating_point_v<V>) {
+		result = std::to_chars(out, out + NUMBER_MAX_SIZE, static_cast<double>(value), std::chars_format::general, 6);
+	} else {
+		result = std::to_chars(out, out + NUMBER_MAX_SIZE, static_cast<long long>(value));
+	}
+
+	return static_cast<std::size_t>(result.ptr - out);
+}
+
+class OstreamSink {
+public:
+	explicit OstreamSink(std::basic_ostream<char> & stream_)
+		:	stream(stream_) {}
+
+	void write(const char * data, std::size_t size) {
+		stream.write(data, static_cast<std::streamsize>(size));
+	}
+
+private:
+	std::basic_ostream<char> & stream;
+};
+
+class CountingSink {
+public:
+	void write(const char *, std::size_t size) {
+		count += size;
+	}
+
+	std::size_t count = 0;
+};
+
+class BufferSink {
+public:
+	BufferSink(char * buffer_, std::size_t capacity_)
+		:	buffer(buffer_), capacity(capacity_) {}
+
+	void write(const char * data, std::size_t size) {
+		if (count + size <= capacity) std::memcpy(buffer + count, data, size);
+		count += size;
+	}
+
+	std::size_t count = 0;
+
+private:
+	char * buffer;
+	std::size_t capacity;
+};
+
+class StringSink {
+public:
+	explicit StringSink(std::string & string_)
+		:	string(string_) {}
+
+	void write(const char * data, std::size_t size) {
+		string.append(data, size);
+	}
+
+private:
+	std::string & string;
+};
+
+template<typename Sink>
+class Writer {
+public:
+	explicit Writer(Sink & sink_)
+		:	sink(sink_) {}
+
+	Writer(Sink & sink_, std::string indent_)
+		:	sink(sink_), pretty(true), indent(std::move(indent_)) {}
+
+	void install() {
+		F_iterate_over::set_bool = [this] (const std::string & name, bool value) {
+			if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.set_bool: " << name << " : " << std::boolalpha << value << std::endl;
+			begin_value(name);
+			if (value) write("true", 4);
+			else write("false", 5);
+		};
+
+		F_iterate_over::set_integral = [this] (const std::string & name, long long value) {
+			if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.set_integral: " << name << " : " << value << std::endl;
+			begin_value(name);
+			write_number(value);
+		};
+
+		F_iterate_over::set_floating_point = [this] (const std::string & name, double value) {
+			if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.set_floating_point: " << name << " : " << value << std::endl;
+			begin_value(name);
+			write_number(value);
+		};
+
+		F_iterate_over::set_string = [this] (const std::string & name, std::string_view value) {
+			if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.set_string: " << name << " : " << value << std::endl;
+			begin_value(name);
+			write_string(value);
+		};
+
+		F_iterate_over::start_struct = [this] (const std::string & name) {
+			if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.start_struct: " << name << std::endl;
+			begin_container(name, pretty && indent_count != 0);
+			write("{", 1);
+		};
+
+		F_iterate_over::end_struct = [this] {
+			if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.end_struct:" << std::endl;
+			end_container();
+			write("}", 1);
+		};
+
+		F_iterate_over::start_array = [this] (const std::string & name) {
+			if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.start_array: " << name << std::endl;
+			begin_container(name, pretty);
+			write("[", 1);
+		};
+
+		F_iterate_over::end_array = [this] {
+			if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.end_array:" << std::endl;
+			end_container();
+			write("]", 1);
+		};
+
+		F_iterate_over::set_raw = [this] (const std::string & name, std::string_view value) {
+			if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.set_raw: " << name << " : " << value << std::endl;
+			begin_value(name);
+			if (value.empty()) write("null", 4);
+			else write(value.data(), value.size());
+		};
+
+		if (pretty) {
+			F_iterate_over::set_elements = nullptr;
+		} else {
+			F_iterate_over::set_elements = [this] (const std::string_view * parts, std::size_t count) {
+				if constexpr (debug) std::cout << "struct_mapping: map_struct_to_json.set_elements: " << count << std::endl;
+				write_elements(parts, count);
+			};
+		}
+	}
+
+private:
+	Sink & sink;
+	bool pretty = false;
+	std::string indent;
+	bool first_element = true;
+	int indent_count = 0;
+
+	void write(const char * data, std::size_t size) {
+		sink.write(data, size);
+	}
+
+	template<typename V>
+	void write_number(V value) {
+		char buffer[NUMBER_MAX_SIZE];
+		write(buffer, format_number(buffer, value));
+	}
+
+	void write_elements(const std::string_view * parts, std::size_t count) {
+		if constexpr (has_writev_v<Sink>) {
+			std::vector<std::string_view> vector;
+			vector.reserve(count * 2);
+			for (std::size_t i = 0; i < count; ++i) {
+				if (parts[i].empty()) continue;
+				if (!first_element) vector.emplace_back(",", 1);
+				vector.push_back(parts[i]);
+				first_element = false;
+			}
+			if (!vector.empty()) sink.writev(vector.data(), vector.size());
+		} else {
+			for (std::size_t i = 0; i < count; ++i) {
+				if (parts[i].empty()) continue;
+				if (!first_element) write(",", 1);
+				write(parts[i].data(), parts[i].size());
+				first_element = false;
+			}
+		}
+	}
+
+	void write_indent() {
+		for (int i = indent_count; i != 0; --i) write(indent.data(), indent.size());
+	}
+
+	void write_string(std::string_view value) {
+		write("\"", 1);
+
+		auto first = value.data();
+		auto last = value.data() + value.size();
+		for (auto it = first; it != last; ++it) {
+			auto ch = static_cast<unsigned char>(*it);
+			if (ch >= 0x20 && ch != '\"' && ch != '\\') continue;
+
+			write(first, static_cast<std::size_t>(it - first));
+			write_escape(ch);
+			first = it + 1;
+		}
+		write(first, static_cast<std::size_t>(last - first));
+
+		write("\"", 1);
+	}
+
+	void write_escape(unsigned char ch) {
+		switch (ch) {
+		case '\"': write("\\\"", 2); break;
+		case '\\': write("\\\\", 2); break;
+		case '\b': write("\\b", 2); break;
+		case '\f': write("\\f", 2); break;
+		case '\n': write("\\n", 2); break;
+		case '\r': write("\\r", 2); break;
+		case '\t': write("\\t", 2); break;
+		default: {
+			constexpr const char * HEX_DIGITS = "0123456789abcdef";
+			char escape[6] = {'\\', 'u', '0', '0', HEX_DIGITS[ch >> 4], HEX_DIGITS[ch & 0xF]};
+			write(escape, 6);
+		}
+		}
+	}
+
+	void write_name(const std::string & name) {
+		write_string(name);
+		if (pretty) write(": ", 2);
+		else write(":", 1);
+	}
+
+	void begin_value(const std::string & name) {
+		if (!first_element) write(",", 1);
+		if (pretty) {
+			write("\n", 1);
+			write_indent();
+		}
+		if (!name.empty()) write_name(name);
+		first_element = false;
+	}
+
+	void begin_container(const std::string & name, bool new_line) {
+		if (!first_element) write(",", 1);
+		if (new_line) write("\n", 1);
+		if (pretty) write_indent();
+		if (!name.empty()) write_name(name);
+		first_element = true;
+		++indent_count;
+	}
+
+	void end_container() {
+		--indent_count;
+		if (pretty) {
+			write("\n", 1);
+			write_indent();
+		}
+		first_element = false;
+	}
+};
+
+}
+
+#endif
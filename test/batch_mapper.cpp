@@ -0,0 +1,113 @@
+#include <array>
+#include <future>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "struct_mapping/struct_mapping.h"
+
+using ::testing::ElementsAre;
+
+namespace {
+
+struct Struct_batch_item {
+	int id = 0;
+	std::string_view name;
+};
+
+struct Struct_batch {
+	int id = 0;
+	std::vector<Struct_batch_item> items;
+};
+
+void reg_batch() {
+	struct_mapping::reg(&Struct_batch_item::id, "id");
+	struct_mapping::reg(&Struct_batch_item::name, "name");
+	struct_mapping::reg(&Struct_batch::id, "id");
+	struct_mapping::reg(&Struct_batch::items, "items");
+}
+
+std::string document(int id) {
+	return "{\"id\": " + std::to_string(id) + ", \"items\": [{\"id\": " + std::to_string(id * 2) + ", \"name\": \"n" + std::to_string(id) + "\"}]}";
+}
+
+TEST(struct_mapping_batch_mapper, map) {
+	reg_batch();
+
+	std::vector<std::string> documents;
+	for (int i = 0; i < 1000; ++i) documents.push_back(document(i));
+
+	struct_mapping::BatchMapper<Struct_batch> mapper(4);
+	ASSERT_EQ(mapper.threads(), 4);
+
+	std::vector<Struct_batch> result(5);
+	mapper.map(result, documents);
+
+	ASSERT_EQ(result.size(), 1000);
+	for (int i = 0; i < 1000; ++i) {
+		auto & value = result[static_cast<std::size_t>(i)];
+		ASSERT_EQ(value.id, i);
+		ASSERT_EQ(value.items.size(), 1);
+		ASSERT_EQ(value.items[0].id, i * 2);
+		ASSERT_EQ(value.items[0].name, "n" + std::to_string(i));
+	}
+
+	std::array<std::string_view, 2> small{R"json({"id": 1})json", R"json({"id": 2, "items": []})json"};
+	mapper.map(result, small);
+
+	ASSERT_EQ(result.size(), 2);
+	ASSERT_EQ(result[0].id, 1);
+	ASSERT_EQ(result[1].id, 2);
+	ASSERT_TRUE(result[1].items.empty());
+}
+
+TEST(struct_mapping_batch_mapper, submit) {
+	reg_batch();
+
+	std::vector<std::string> documents;
+	for (int i = 0; i < 100; ++i) documents.push_back(document(i));
+
+	struct_mapping::BatchMapper<Struct_batch> mapper(3);
+	std::vector<std::future<Struct_batch>> results;
+	for (auto & json_data : documents) results.push_back(mapper.submit(json_data));
+
+	for (int i = 0; i < 100; ++i) {
+		auto value = results[static_cast<std::size_t>(i)].get();
+		ASSERT_EQ(value.id, i);
+		ASSERT_EQ(value.items[0].name, "n" + std::to_string(i));
+	}
+
+	auto bad = mapper.submit(R"json({"id": "bad"})json");
+	try {
+		bad.get();
+	} catch (struct_mapping::StructMappingException &) {
+		return;
+	}
+
+	FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws nothing";
+}
+
+TEST(struct_mapping_batch_mapper, map_bad_document) {
+	reg_batch();
+
+	std::vector<std::string> documents;
+	for (int i = 0; i < 100; ++i) documents.push_back(document(i));
+	documents[50] = R"json({"id": 50, "items": [{"id": "bad"}]})json";
+
+	struct_mapping::BatchMapper<Struct_batch> mapper(4);
+	std::vector<Struct_batch> result;
+
+	try {
+		mapper.map(result, documents);
+	} catch (struct_mapping::StructMappingException & e) {
+		ASSERT_STREQ(e.what(), "bad type (string) for member: id");
+		return;
+	}
+
+	FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws nothing";
+}
+
+}
@@ -0,0 +1,112 @@
+#include <string>
+#include <string_view>
+
+#include "gtest/gtest.h"
+
+#include "struct_mapping/struct_mapping.h"
+
+namespace {
+
+const std::string json_data(R"json(
+{
+	"skipped": {"a": [1, {"b": "}]\""}], "c": null},
+	"request": {
+		"id": 42,
+		"price": 1.5e2,
+		"active": true,
+		"route": "orders/create",
+		"tags": ["first", "sec\"ond", {"name": "third"}],
+		"a/b": -7,
+		"m~n": "tilde",
+		"color": "green",
+		"payload": {"x": [1, 2]}
+	}
+}
+)json");
+
+enum class Color {
+	red,
+	green,
+};
+
+struct Struct_tag {
+	std::string name;
+};
+
+TEST(extract, values) {
+	ASSERT_EQ(struct_mapping::extract<int>(json_data, "/request/id"), 42);
+	ASSERT_EQ(struct_mapping::extract<double>(json_data, "/request/id"), 42.0);
+	ASSERT_EQ(struct_mapping::extract<double>(json_data, "/request/price"), 150.0);
+	ASSERT_EQ(struct_mapping::extract<bool>(json_data, "/request/active"), true);
+	ASSERT_EQ(struct_mapping::extract<std::string>(json_data, "/request/route"), "orders/create");
+	ASSERT_EQ(struct_mapping::extract<std::string>(json_data, "/request/tags/1"), "sec\"ond");
+	ASSERT_EQ(struct_mapping::extract<std::string>(json_data, "/request/tags/2/name"), "third");
+	ASSERT_EQ(struct_mapping::extract<short>(json_data, "/request/a~1b"), -7);
+	ASSERT_EQ(struct_mapping::extract<std::string>(json_data, "/request/m~0n"), "tilde");
+	ASSERT_EQ(struct_mapping::extract<struct_mapping::RawJson>(json_data, "/request/payload").get(), R"json({"x": [1, 2]})json");
+
+	auto route = struct_mapping::extract<std::string_view>(json_data, "/request/route");
+	ASSERT_EQ(route.data(), json_data.data() + json_data.find("orders/create"));
+}
+
+TEST(extract, enum) {
+	struct_mapping::MemberString<Color>::set(
+		[] (const std::string & value) {
+			if (value == "red") return Color::red;
+			if (value == "green") return Color::green;
+			throw struct_mapping::StructMappingException("bad convert '" + value + "' to Color");
+		},
+		[] (Color value) {
+			return value == Color::red ? std::string("red") : std::string("green");
+		});
+
+	ASSERT_EQ(struct_mapping::extract<Color>(json_data, "/request/color"), Color::green);
+}
+
+TEST(extract, structure) {
+	struct_mapping::reg(&Struct_tag::name, "name");
+
+	ASSERT_EQ(struct_mapping::extract<Struct_tag>(json_data, "/request/tags/2").name, "third");
+}
+
+TEST(extract, not_found) {
+	for (auto pointer : {"/request/missing", "/request/tags/3", "/request/tags/01", "/request/id/value", "request"}) {
+		try {
+			struct_mapping::extract<int>(json_data, pointer);
+		} catch (struct_mapping::StructMappingException& e) {
+			continue;
+		} catch (...) {
+			FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws a different type";
+		}
+
+		FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws nothing";
+	}
+}
+
+TEST(extract, bad_type) {
+	for (auto pointer : {"/request/route", "/request/price", "/request/tags"}) {
+		try {
+			struct_mapping::extract<int>(json_data, pointer);
+		} catch (struct_mapping::StructMappingException& e) {
+			continue;
+		} catch (...) {
+			FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws a different type";
+		}
+
+		FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws nothing";
+	}
+}
+
+TEST(extract, out_of_limits) {
+	try {
+		struct_mapping::extract<unsigned char>(json_data, "/request/a~1b");
+	} catch (struct_mapping::StructMappingException& e) {
+		return;
+	} catch (...) {
+		FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws a different type";
+	}
+
+	FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws nothing";
+}
+
+}
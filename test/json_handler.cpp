@@ -0,0 +1,85 @@
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "struct_mapping/struct_mapping.h"
+
+using ::testing::ElementsAre;
+
+namespace {
+
+class Sum_handler : public struct_mapping::JsonHandler {
+public:
+	bool on_integral(std::string_view name, long long value) {
+		if (name == "amount") {
+			sum += value;
+			++count;
+		}
+		return true;
+	}
+
+	void on_string(std::string_view name, std::string_view value) {
+		if (name == "currency") currencies.emplace_back(value);
+	}
+
+	long long sum = 0;
+	int count = 0;
+	std::vector<std::string> currencies;
+};
+
+TEST(json_handler, aggregate) {
+	std::string json_data("{\"payments\": [");
+	for (int i = 0; i < 5000; ++i) {
+		json_data += (i == 0 ? "" : ", ") + std::string("{\"amount\": ") + std::to_string(i) + ", \"currency\": \"" + (i % 2 ? "EUR" : "USD") + "\", \"note\": null}";
+	}
+	json_data += "]}";
+
+	Sum_handler handler;
+	std::istringstream json_stream(json_data);
+
+	ASSERT_TRUE(struct_mapping::parse_json(json_stream, handler));
+	ASSERT_EQ(handler.count, 5000);
+	ASSERT_EQ(handler.sum, 5000LL * 4999 / 2);
+	ASSERT_EQ(handler.currencies.size(), 5000);
+	ASSERT_EQ(handler.currencies[1], "EUR");
+}
+
+class Find_handler : public struct_mapping::JsonHandler {
+public:
+	bool on_start_struct(std::string_view name) {
+		events.push_back("start:" + std::string(name));
+		return true;
+	}
+
+	bool on_string(std::string_view name, std::string_view value) {
+		events.push_back(std::string(name) + ":" + std::string(value));
+		return name != "id";
+	}
+
+	std::vector<std::string> events;
+};
+
+TEST(json_handler, stop) {
+	Find_handler handler;
+	std::istringstream json_stream(R"json({"id": "first", "rest": {"a": "b"}} tail)json");
+
+	ASSERT_FALSE(struct_mapping::parse_json(json_stream, handler));
+	ASSERT_THAT(handler.events, ElementsAre("start:", "id:first"));
+
+	std::string rest;
+	std::getline(json_stream, rest);
+	ASSERT_EQ(rest, R"json(, "rest": {"a": "b"}} tail)json");
+}
+
+TEST(json_handler, buffer) {
+	Find_handler handler;
+
+	ASSERT_TRUE(struct_mapping::parse_json(std::string_view(R"json({"a": {"b": "c\nd"}})json"), handler));
+	ASSERT_THAT(handler.events, ElementsAre("start:", "start:a", "b:c\nd"));
+}
+
+}
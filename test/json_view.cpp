@@ -0,0 +1,89 @@
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "struct_mapping/struct_mapping.h"
+
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+namespace {
+
+struct Struct_view_nested {
+	int id = 0;
+	std::string name;
+};
+
+struct Struct_view {
+	unsigned char small = 0;
+	std::string_view route;
+	double price = 0;
+	std::vector<int> numbers;
+	std::map<std::string, bool> flags;
+	Struct_view_nested nested;
+	std::string missing = "initial";
+};
+
+const std::string json_data(R"json(
+{
+	"small": 1000,
+	"route": "orders/create",
+	"price": 12.5,
+	"unknown": {"a": [1, "}"]},
+	"numbers": [1, 2, 3],
+	"flags": {"on": true, "off": false},
+	"nested": {"id": 7, "name": "seventh"}
+}
+)json");
+
+void reg_view() {
+	struct_mapping::reg(&Struct_view_nested::id, "id");
+	struct_mapping::reg(&Struct_view_nested::name, "name");
+	struct_mapping::reg(&Struct_view::small, "small");
+	struct_mapping::reg(&Struct_view::route, "route");
+	struct_mapping::reg(&Struct_view::price, "price");
+	struct_mapping::reg(&Struct_view::numbers, "numbers");
+	struct_mapping::reg(&Struct_view::flags, "flags");
+	struct_mapping::reg(&Struct_view::nested, "nested");
+	struct_mapping::reg(&Struct_view::missing, "missing");
+}
+
+TEST(json_view, get) {
+	reg_view();
+
+	struct_mapping::JsonView<Struct_view> view(json_data);
+
+	ASSERT_EQ(view.get(&Struct_view::price), 12.5);
+	ASSERT_EQ(view.get(&Struct_view::route), "orders/create");
+	ASSERT_EQ(view.get(&Struct_view::route).data(), json_data.data() + json_data.find("orders/create"));
+	ASSERT_THAT(view.get(&Struct_view::numbers), ElementsAre(1, 2, 3));
+	ASSERT_THAT(view.get(&Struct_view::flags), ElementsAre(Pair("off", false), Pair("on", true)));
+	ASSERT_EQ(view.get(&Struct_view::nested).id, 7);
+	ASSERT_EQ(view.get(&Struct_view::nested).name, "seventh");
+	ASSERT_EQ(view.get(&Struct_view::missing), "initial");
+	ASSERT_EQ(&view.get(&Struct_view::price), &view.get(&Struct_view::price));
+}
+
+TEST(json_view, get_bad_value) {
+	reg_view();
+
+	struct_mapping::JsonView<Struct_view> view(json_data);
+
+	ASSERT_EQ(view.get(&Struct_view::price), 12.5);
+
+	try {
+		view.get(&Struct_view::small);
+	} catch (struct_mapping::StructMappingException& e) {
+		return;
+	} catch (...) {
+		FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws a different type";
+	}
+
+	FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws nothing";
+}
+
+}
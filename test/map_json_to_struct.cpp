@@ -1,8 +1,13 @@
 #include <cstdint>
+#include <iterator>
 #include <list>
 #include <map>
+#include <memory_resource>
+#include <mutex>
+#include <set>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -527,6 +532,39 @@ TEST(struct_mapping_map_json_to_struct, member_map_struct_struct) {
 	ASSERT_EQ(result_struct.member_map_struct_b["2"].member_struct_a.member_string, "second");
 }
 
+struct Struct_map_unsorted_keys {
+	std::map<std::string, int> member_map_int;
+	std::multimap<std::string, int> member_multimap_int;
+};
+
+TEST(struct_mapping_map_json_to_struct, member_map_unsorted_keys) {
+	Struct_map_unsorted_keys result_struct;
+
+	struct_mapping::reg(&Struct_map_unsorted_keys::member_map_int, "member_map_int");
+	struct_mapping::reg(&Struct_map_unsorted_keys::member_multimap_int, "member_multimap_int");
+
+	std::istringstream json_data(R"json(
+	{
+		"member_map_int": {
+			"third_key_longer_than_small_string": 3,
+			"first": 1,
+			"second": 2,
+			"first": 4
+		},
+		"member_multimap_int": {
+			"second": 2,
+			"first": 1,
+			"second": 3
+		}
+	}
+	)json");
+
+	struct_mapping::map_json_to_struct(result_struct, json_data);
+
+	ASSERT_THAT(result_struct.member_map_int, ElementsAre(Pair("first", 1), Pair("second", 2), Pair("third_key_longer_than_small_string", 3)));
+	ASSERT_THAT(result_struct.member_multimap_int, ElementsAre(Pair("first", 1), Pair("second", 2), Pair("second", 3)));
+}
+
 enum Enum {
 	Enum_v1,
 	Enum_v2,
@@ -656,4 +694,753 @@ TEST(struct_mapping_map_json_to_struct, enum_map) {
 	ASSERT_THAT(result_struct.values, ElementsAre(Pair("first", Enum_map::v2), Pair("second", Enum_map::v3), Pair("third", Enum_map::v2)));
 }
 
+
+struct Struct_numeric_vector_A {
+	std::vector<int> member_int;
+	std::vector<std::vector<double>> member_matrix;
+};
+
+struct Struct_numeric_vector_B {
+	std::vector<double> member_double;
+	std::vector<float> member_float;
+	std::vector<Struct_numeric_vector_A> member_vector_struct;
+	std::map<std::string, std::vector<long long>> member_map;
+};
+
+TEST(struct_mapping_map_json_to_struct, member_numeric_vector) {
+	Struct_numeric_vector_B result_struct;
+
+	struct_mapping::reg(&Struct_numeric_vector_A::member_int, "member_int");
+	struct_mapping::reg(&Struct_numeric_vector_A::member_matrix, "member_matrix");
+	struct_mapping::reg(&Struct_numeric_vector_B::member_double, "member_double");
+	struct_mapping::reg(&Struct_numeric_vector_B::member_float, "member_float");
+	struct_mapping::reg(&Struct_numeric_vector_B::member_vector_struct, "member_vector_struct");
+	struct_mapping::reg(&Struct_numeric_vector_B::member_map, "member_map");
+
+	std::istringstream json_data(R"json(
+	{
+		"member_double": [1, -2.5, 3e2 , .5
+		],
+		"member_float": [],
+		"member_vector_struct": [
+			{
+				"member_int": [7, -8, 9],
+				"member_matrix": [[1, 2], [], [3.5]]
+			}
+		],
+		"member_map": {
+			"first": [1, 2],
+			"second": [-9000000000]
+		}
+	}
+	)json");
+
+	struct_mapping::map_json_to_struct(result_struct, json_data);
+
+	ASSERT_THAT(result_struct.member_double, ElementsAre(1, -2.5, 300, 0.5));
+	ASSERT_TRUE(result_struct.member_float.empty());
+	ASSERT_EQ(result_struct.member_vector_struct.size(), 1);
+	ASSERT_THAT(result_struct.member_vector_struct[0].member_int, ElementsAre(7, -8, 9));
+	ASSERT_THAT(result_struct.member_vector_struct[0].member_matrix, ElementsAre(ElementsAre(1, 2), ElementsAre(), ElementsAre(3.5)));
+	ASSERT_THAT(result_struct.member_map, ElementsAre(Pair("first", ElementsAre(1, 2)), Pair("second", ElementsAre(-9000000000))));
+}
+
+TEST(struct_mapping_map_json_to_struct, member_numeric_vector_bad_type) {
+	Struct_numeric_vector_A result_struct;
+
+	std::istringstream json_data(R"json(
+	{
+		"member_int": [1, 2.5]
+	}
+	)json");
+
+	try {
+		struct_mapping::map_json_to_struct(result_struct, json_data);
+	} catch (struct_mapping::StructMappingException& e) {
+		ASSERT_EQ(std::string(e.what()), std::string("bad type (floating point) '2.500000' in array_like at index 1"));
+		return;
+	} catch (...) {
+		FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws a different type";
+	}
+
+	FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws nothing";
+}
+
+TEST(struct_mapping_map_json_to_struct, member_numeric_vector_out_of_limits) {
+	Struct_numeric_vector_A result_struct;
+
+	std::istringstream json_data(R"json(
+	{
+		"member_int": [1, 2, 3000000000]
+	}
+	)json");
+
+	try {
+		struct_mapping::map_json_to_struct(result_struct, json_data);
+	} catch (struct_mapping::StructMappingException& e) {
+		ASSERT_EQ(std::string(e.what()), std::string("bad value '3000000000' in array_like at index 2 is out of limits of type [-2147483648 : 2147483647]"));
+		return;
+	} catch (...) {
+		FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws a different type";
+	}
+
+	FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws nothing";
+}
+
+
+class Counting_resource : public std::pmr::memory_resource {
+public:
+	int allocations = 0;
+
+private:
+	void * do_allocate(std::size_t bytes, std::size_t alignment) override {
+		++allocations;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void * p, std::size_t bytes, std::size_t alignment) override {
+		std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override {
+		return this == &other;
+	}
+};
+
+struct Struct_memory_resource_A {
+	std::pmr::string member_string;
+};
+
+struct Struct_memory_resource_B {
+	std::pmr::string member_string;
+	std::pmr::vector<std::pmr::string> member_vector_string;
+	std::pmr::vector<double> member_vector_double;
+	std::pmr::map<std::pmr::string, int> member_map_int;
+	std::vector<Struct_memory_resource_A> member_vector_struct;
+	std::list<std::pmr::string> member_list_string;
+};
+
+TEST(struct_mapping_map_json_to_struct, memory_resource) {
+	Counting_resource resource;
+	auto default_resource = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+
+	Struct_memory_resource_B result_struct;
+
+	struct_mapping::reg(&Struct_memory_resource_A::member_string, "member_string");
+	struct_mapping::reg(&Struct_memory_resource_B::member_string, "member_string");
+	struct_mapping::reg(&Struct_memory_resource_B::member_vector_string, "member_vector_string");
+	struct_mapping::reg(&Struct_memory_resource_B::member_vector_double, "member_vector_double");
+	struct_mapping::reg(&Struct_memory_resource_B::member_map_int, "member_map_int");
+	struct_mapping::reg(&Struct_memory_resource_B::member_vector_struct, "member_vector_struct");
+	struct_mapping::reg(&Struct_memory_resource_B::member_list_string, "member_list_string");
+
+	std::istringstream json_data(R"json(
+	{
+		"member_string": "string longer than the small string buffer",
+		"member_vector_string": ["first string longer than the small string buffer", "second"],
+		"member_vector_double": [1.5, 2.5],
+		"member_map_int": {
+			"first key longer than the small string buffer": 1,
+			"second": 2
+		},
+		"member_vector_struct": [
+			{"member_string": "string in struct longer than the small string buffer"}
+		],
+		"member_list_string": ["string in list longer than the small string buffer"]
+	}
+	)json");
+
+	try {
+		struct_mapping::map_json_to_struct(result_struct, json_data, &resource);
+	} catch (...) {
+		std::pmr::set_default_resource(default_resource);
+		throw;
+	}
+	std::pmr::set_default_resource(default_resource);
+
+	ASSERT_EQ(result_struct.member_string, "string longer than the small string buffer");
+	ASSERT_THAT(result_struct.member_vector_string, ElementsAre("first string longer than the small string buffer", "second"));
+	ASSERT_THAT(result_struct.member_vector_double, ElementsAre(1.5, 2.5));
+	ASSERT_THAT(result_struct.member_map_int, ElementsAre(Pair("first key longer than the small string buffer", 1), Pair("second", 2)));
+	ASSERT_EQ(result_struct.member_vector_struct.size(), 1);
+	ASSERT_EQ(result_struct.member_vector_struct[0].member_string, "string in struct longer than the small string buffer");
+	ASSERT_THAT(result_struct.member_list_string, ElementsAre("string in list longer than the small string buffer"));
+
+	ASSERT_EQ(result_struct.member_string.get_allocator().resource(), &resource);
+	ASSERT_EQ(result_struct.member_vector_string.get_allocator().resource(), &resource);
+	ASSERT_EQ(result_struct.member_vector_string[0].get_allocator().resource(), &resource);
+	ASSERT_EQ(result_struct.member_map_int.begin()->first.get_allocator().resource(), &resource);
+	ASSERT_EQ(result_struct.member_vector_struct[0].member_string.get_allocator().resource(), &resource);
+	ASSERT_EQ(result_struct.member_list_string.front().get_allocator().resource(), &resource);
+	ASSERT_GE(resource.allocations, 9);
+}
+
+
+struct Struct_reuse_A {
+	std::string member_string;
+	int member_int = 0;
+};
+
+struct Struct_reuse_B {
+	std::string member_string;
+	std::vector<double> member_vector_double;
+	std::vector<std::string> member_vector_string;
+	std::vector<Struct_reuse_A> member_vector_struct;
+	std::list<int> member_list_int;
+	std::set<int> member_set_int;
+	std::map<std::string, std::string> member_map_string;
+	std::vector<std::vector<int>> member_vector_vector_int;
+};
+
+TEST(struct_mapping_map_json_to_struct, reuse) {
+	Struct_reuse_B result_struct;
+
+	struct_mapping::reg(&Struct_reuse_A::member_string, "member_string");
+	struct_mapping::reg(&Struct_reuse_A::member_int, "member_int");
+	struct_mapping::reg(&Struct_reuse_B::member_string, "member_string");
+	struct_mapping::reg(&Struct_reuse_B::member_vector_double, "member_vector_double");
+	struct_mapping::reg(&Struct_reuse_B::member_vector_string, "member_vector_string");
+	struct_mapping::reg(&Struct_reuse_B::member_vector_struct, "member_vector_struct");
+	struct_mapping::reg(&Struct_reuse_B::member_list_int, "member_list_int");
+	struct_mapping::reg(&Struct_reuse_B::member_set_int, "member_set_int");
+	struct_mapping::reg(&Struct_reuse_B::member_map_string, "member_map_string");
+	struct_mapping::reg(&Struct_reuse_B::member_vector_vector_int, "member_vector_vector_int");
+
+	std::istringstream first_json_data(R"json(
+	{
+		"member_string": "first string longer than the small string buffer",
+		"member_vector_double": [1.5, 2.5, 3.5],
+		"member_vector_string": ["first string longer than the small string buffer", "second", "third"],
+		"member_vector_struct": [
+			{"member_string": "first", "member_int": 1},
+			{"member_string": "second", "member_int": 2}
+		],
+		"member_list_int": [1, 2, 3],
+		"member_set_int": [1, 2, 3],
+		"member_map_string": {"first": "1", "second": "2"},
+		"member_vector_vector_int": [[1, 2], [3]]
+	}
+	)json");
+
+	struct_mapping::map_json_to_struct(result_struct, first_json_data, struct_mapping::Reuse{});
+
+	auto member_string_data = result_struct.member_string.data();
+	auto member_vector_double_data = result_struct.member_vector_double.data();
+	auto member_vector_string_data = result_struct.member_vector_string[0].data();
+	auto member_vector_struct_data = result_struct.member_vector_struct.data();
+	auto member_list_int_front = &result_struct.member_list_int.front();
+	auto member_map_string_node = &result_struct.member_map_string.begin()->second;
+
+	std::istringstream second_json_data(R"json(
+	{
+		"member_string": "second string",
+		"member_vector_double": [4.5, 5.5],
+		"member_vector_string": ["fourth"],
+		"member_vector_struct": [
+			{"member_string": "third"}
+		],
+		"member_list_int": [4],
+		"member_set_int": [5, 4],
+		"member_map_string": {"third": "3"},
+		"member_vector_vector_int": [[4]]
+	}
+	)json");
+
+	struct_mapping::map_json_to_struct(result_struct, second_json_data, struct_mapping::Reuse{});
+
+	ASSERT_EQ(result_struct.member_string, "second string");
+	ASSERT_THAT(result_struct.member_vector_double, ElementsAre(4.5, 5.5));
+	ASSERT_THAT(result_struct.member_vector_string, ElementsAre("fourth"));
+	ASSERT_EQ(result_struct.member_vector_struct.size(), 1);
+	ASSERT_EQ(result_struct.member_vector_struct[0].member_string, "third");
+	ASSERT_EQ(result_struct.member_vector_struct[0].member_int, 1);
+	ASSERT_THAT(result_struct.member_list_int, ElementsAre(4));
+	ASSERT_THAT(result_struct.member_set_int, ElementsAre(4, 5));
+	ASSERT_THAT(result_struct.member_map_string, ElementsAre(Pair("third", "3")));
+	ASSERT_THAT(result_struct.member_vector_vector_int, ElementsAre(ElementsAre(4)));
+
+	ASSERT_EQ(result_struct.member_string.data(), member_string_data);
+	ASSERT_EQ(result_struct.member_vector_double.data(), member_vector_double_data);
+	ASSERT_EQ(result_struct.member_vector_string[0].data(), member_vector_string_data);
+	ASSERT_EQ(result_struct.member_vector_struct.data(), member_vector_struct_data);
+	ASSERT_EQ(&result_struct.member_list_int.front(), member_list_int_front);
+	ASSERT_EQ(&result_struct.member_map_string.begin()->second, member_map_string_node);
+}
+
+
+struct Struct_string_view {
+	std::string_view member_string_view;
+	std::vector<std::string_view> member_vector_string_view;
+	std::map<std::string, std::string_view> member_map_string_view;
+};
+
+TEST(struct_mapping_map_json_to_struct, string_view) {
+	Struct_string_view result_struct;
+
+	struct_mapping::reg(&Struct_string_view::member_string_view, "member_string_view");
+	struct_mapping::reg(&Struct_string_view::member_vector_string_view, "member_vector_string_view");
+	struct_mapping::reg(&Struct_string_view::member_map_string_view, "member_map_string_view");
+
+	std::string json_data(R"json(
+	{
+		"member_string_view": "first",
+		"member_vector_string_view": ["second", "third"],
+		"member_map_string_view": {"key": "fourth"}
+	}
+	)json");
+
+	struct_mapping::map_json_to_struct(result_struct, std::string_view(json_data));
+
+	ASSERT_EQ(result_struct.member_string_view, "first");
+	ASSERT_THAT(result_struct.member_vector_string_view, ElementsAre("second", "third"));
+	ASSERT_THAT(result_struct.member_map_string_view, ElementsAre(Pair("key", "fourth")));
+
+	ASSERT_EQ(result_struct.member_string_view.data(), json_data.data() + json_data.find("first"));
+	ASSERT_EQ(result_struct.member_vector_string_view[1].data(), json_data.data() + json_data.find("third"));
+	ASSERT_EQ(result_struct.member_map_string_view["key"].data(), json_data.data() + json_data.find("fourth"));
+}
+
+TEST(struct_mapping_map_json_to_struct, string_view_escaped) {
+	Struct_string_view result_struct;
+
+	struct_mapping::reg(&Struct_string_view::member_string_view, "member_string_view");
+
+	std::string json_data(R"json({"member_string_view": "first\tsecond"})json");
+	std::pmr::monotonic_buffer_resource resource;
+
+	struct_mapping::map_json_to_struct(result_struct, std::string_view(json_data), &resource);
+
+	ASSERT_EQ(result_struct.member_string_view, "first\tsecond");
+}
+
+TEST(struct_mapping_map_json_to_struct, string_view_escaped_without_memory_resource) {
+	Struct_string_view result_struct;
+
+	struct_mapping::reg(&Struct_string_view::member_string_view, "member_string_view");
+
+	std::string json_data(R"json({"member_string_view": "first\tsecond"})json");
+
+	try {
+		struct_mapping::map_json_to_struct(result_struct, std::string_view(json_data));
+	} catch (struct_mapping::StructMappingException& e) {
+		return;
+	} catch (...) {
+		FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws a different type";
+	}
+
+	FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws nothing";
+}
+
+struct Struct_escapes {
+	std::string member_string;
+	std::vector<std::string> member_vector_string;
+};
+
+TEST(struct_mapping_map_json_to_struct, escapes) {
+	Struct_escapes result_struct;
+
+	struct_mapping::reg(&Struct_escapes::member_string, "member_string");
+	struct_mapping::reg(&Struct_escapes::member_vector_string, "member_vector_string");
+
+	std::istringstream json_data(R"json(
+	{
+		"member_string": "quote \" backslash \\ slash \/ controls \b\f\n\r\t",
+		"member_vector_string": ["\u0041\u00e9\u20AC", "\ud83d\ude00"]
+	}
+	)json");
+
+	struct_mapping::map_json_to_struct(result_struct, json_data);
+
+	ASSERT_EQ(result_struct.member_string, "quote \" backslash \\ slash / controls \b\f\n\r\t");
+	ASSERT_THAT(result_struct.member_vector_string, ElementsAre("A\xc3\xa9\xe2\x82\xac", "\xf0\x9f\x98\x80"));
+}
+
+
+struct Struct_raw_json_nested {
+	int id;
+};
+
+struct Struct_raw_json {
+	std::string name;
+	struct_mapping::RawJson payload;
+	struct_mapping::RawJson list;
+	struct_mapping::RawJson scalar;
+	std::vector<struct_mapping::RawJson> member_vector_raw_json;
+	std::map<std::string, struct_mapping::RawJson> member_map_raw_json;
+	Struct_raw_json_nested nested;
+};
+
+TEST(struct_mapping_map_json_to_struct, raw_json) {
+	Struct_raw_json result_struct;
+
+	struct_mapping::reg(&Struct_raw_json_nested::id, "id");
+	struct_mapping::reg(&Struct_raw_json::name, "name");
+	struct_mapping::reg(&Struct_raw_json::payload, "payload");
+	struct_mapping::reg(&Struct_raw_json::list, "list");
+	struct_mapping::reg(&Struct_raw_json::scalar, "scalar");
+	struct_mapping::reg(&Struct_raw_json::member_vector_raw_json, "member_vector_raw_json");
+	struct_mapping::reg(&Struct_raw_json::member_map_raw_json, "member_map_raw_json");
+	struct_mapping::reg(&Struct_raw_json::nested, "nested");
+
+	std::istringstream json_data(R"json(
+	{
+		"name": "first",
+		"payload": {"unknown": [1, {"deep": "}]\""}], "other": null},
+		"list": [true, false],
+		"scalar": -12.5e3,
+		"member_vector_raw_json": [{"a": 1}, "text", 42],
+		"member_map_raw_json": {"x": [], "y": {}},
+		"nested": {"id": 7}
+	}
+	)json");
+
+	struct_mapping::map_json_to_struct(result_struct, json_data);
+
+	ASSERT_EQ(result_struct.name, "first");
+	ASSERT_EQ(result_struct.payload.get(), R"json({"unknown": [1, {"deep": "}]\""}], "other": null})json");
+	ASSERT_EQ(result_struct.list.get(), "[true, false]");
+	ASSERT_EQ(result_struct.scalar.get(), "-12.5e3");
+	ASSERT_EQ(result_struct.member_vector_raw_json.size(), 3);
+	ASSERT_EQ(result_struct.member_vector_raw_json[0].get(), R"json({"a": 1})json");
+	ASSERT_EQ(result_struct.member_vector_raw_json[1].get(), R"json("text")json");
+	ASSERT_EQ(result_struct.member_vector_raw_json[2].get(), "42");
+	ASSERT_EQ(result_struct.member_map_raw_json.size(), 2);
+	ASSERT_EQ(result_struct.member_map_raw_json["x"].get(), "[]");
+	ASSERT_EQ(result_struct.member_map_raw_json["y"].get(), "{}");
+	ASSERT_EQ(result_struct.nested.id, 7);
+}
+
+
+struct Struct_ignore_unknown_nested {
+	int id;
+};
+
+struct Struct_ignore_unknown {
+	std::string name;
+	std::vector<Struct_ignore_unknown_nested> list;
+	Struct_ignore_unknown_nested nested;
+};
+
+TEST(struct_mapping_map_json_to_struct, ignore_unknown) {
+	Struct_ignore_unknown result_struct;
+
+	struct_mapping::reg(&Struct_ignore_unknown_nested::id, "id");
+	struct_mapping::reg(&Struct_ignore_unknown::name, "name");
+	struct_mapping::reg(&Struct_ignore_unknown::list, "list");
+	struct_mapping::reg(&Struct_ignore_unknown::nested, "nested");
+
+	std::string json_data(R"json(
+	{
+		"unknown_object": {"a": [1, {"b": "}]\""}], "c": null},
+		"name": "first",
+		"unknown_array": [[], {}, "]"],
+		"list": [{"id": 1, "unknown": true}, {"unknown": -1.5e3, "id": 2}],
+		"unknown_string": "text \" with quote",
+		"unknown_number": 123456789012345678901234567890,
+		"nested": {"unknown": false, "id": 3},
+		"unknown_null": null
+	}
+	)json");
+
+	struct_mapping::map_json_to_struct(result_struct, std::string_view(json_data), struct_mapping::IgnoreUnknown{});
+
+	ASSERT_EQ(result_struct.name, "first");
+	ASSERT_EQ(result_struct.list.size(), 2);
+	ASSERT_EQ(result_struct.list[0].id, 1);
+	ASSERT_EQ(result_struct.list[1].id, 2);
+	ASSERT_EQ(result_struct.nested.id, 3);
+
+	std::istringstream json_stream(json_data);
+	try {
+		struct_mapping::map_json_to_struct(result_struct, json_stream);
+	} catch (struct_mapping::StructMappingException& e) {
+		return;
+	} catch (...) {
+		FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws a different type";
+	}
+
+	FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws nothing";
+}
+
+
+struct Struct_projection_nested {
+	int id;
+	std::string text;
+};
+
+struct Struct_projection {
+	std::string name;
+	int count = 0;
+	std::vector<int> numbers;
+	std::vector<Struct_projection_nested> list;
+};
+
+TEST(struct_mapping_map_json_to_struct, projection) {
+	Struct_projection result_struct;
+
+	struct_mapping::reg(&Struct_projection_nested::id, "id");
+	struct_mapping::reg(&Struct_projection_nested::text, "text");
+	struct_mapping::reg(&Struct_projection::name, "name");
+	struct_mapping::reg(&Struct_projection::count, "count", struct_mapping::Required{});
+	struct_mapping::reg(&Struct_projection::numbers, "numbers");
+	struct_mapping::reg(&Struct_projection::list, "list");
+
+	struct_mapping::Projection projection;
+	projection.select<Struct_projection>({"name", "list"}).select<Struct_projection_nested>({"id"});
+
+	std::string json_data(R"json(
+	{
+		"name": "first",
+		"numbers": [1, "not a number", 3],
+		"list": [{"id": 1, "text": "a"}, {"text": true, "id": 2}]
+	}
+	)json");
+
+	struct_mapping::map_json_to_struct(result_struct, std::string_view(json_data), projection);
+
+	ASSERT_EQ(result_struct.name, "first");
+	ASSERT_EQ(result_struct.count, 0);
+	ASSERT_TRUE(result_struct.numbers.empty());
+	ASSERT_EQ(result_struct.list.size(), 2);
+	ASSERT_EQ(result_struct.list[0].id, 1);
+	ASSERT_EQ(result_struct.list[0].text, "");
+	ASSERT_EQ(result_struct.list[1].id, 2);
+
+	std::istringstream json_stream(R"json({"name": "second", "count": 5, "numbers": [4], "list": [{"id": 3, "text": "b"}]})json");
+	struct_mapping::map_json_to_struct(result_struct, json_stream);
+
+	ASSERT_EQ(result_struct.count, 5);
+	ASSERT_THAT(result_struct.numbers, ElementsAre(4));
+	ASSERT_EQ(result_struct.list.back().text, "b");
+}
+
+TEST(struct_mapping_map_json_to_struct, projection_bad_member) {
+	struct_mapping::reg(&Struct_projection::name, "name");
+
+	try {
+		struct_mapping::Projection projection;
+		projection.select<Struct_projection>({"name", "missing"});
+	} catch (struct_mapping::StructMappingException& e) {
+		return;
+	} catch (...) {
+		FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws a different type";
+	}
+
+	FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws nothing";
+}
+
+
+struct Struct_stream_record {
+	int id = 0;
+	std::string level;
+	std::vector<std::string> tags;
+};
+
+TEST(struct_mapping_map_json_to_struct, stream) {
+	struct_mapping::reg(&Struct_stream_record::id, "id");
+	struct_mapping::reg(&Struct_stream_record::level, "level");
+	struct_mapping::reg(&Struct_stream_record::tags, "tags");
+
+	std::istringstream json_data(
+		"{\"id\": 1, \"level\": \"info\", \"tags\": [\"a\", \"b\", \"c\"]}\n"
+		"{\"id\": 2, \"level\": \"warn\", \"tags\": [\"d\"]}\n"
+		"\n"
+		"{\"id\": 3, \"level\": \"error\", \"tags\": []}{\"id\": 4, \"level\": \"debug\", \"tags\": [\"e\", \"f\"]}\n");
+
+	std::vector<int> ids;
+	std::vector<std::string> levels;
+	std::vector<std::vector<std::string>> tags;
+	const Struct_stream_record * record_address = nullptr;
+
+	auto count = struct_mapping::map_json_stream<Struct_stream_record>(json_data, [&] (Struct_stream_record & record) {
+		if (record_address == nullptr) record_address = &record;
+		ASSERT_EQ(record_address, &record);
+		ids.push_back(record.id);
+		levels.push_back(record.level);
+		tags.push_back(record.tags);
+	});
+
+	ASSERT_EQ(count, 4);
+	ASSERT_THAT(ids, ElementsAre(1, 2, 3, 4));
+	ASSERT_THAT(levels, ElementsAre("info", "warn", "error", "debug"));
+	ASSERT_THAT(tags, ElementsAre(ElementsAre("a", "b", "c"), ElementsAre("d"), ElementsAre(), ElementsAre("e", "f")));
+}
+
+TEST(struct_mapping_map_json_to_struct, stream_stop) {
+	struct_mapping::reg(&Struct_stream_record::id, "id");
+	struct_mapping::reg(&Struct_stream_record::level, "level");
+	struct_mapping::reg(&Struct_stream_record::tags, "tags");
+
+	std::string json_data("{\"id\": 1}\n{\"id\": 2}\n{\"id\": 3}\n");
+	std::vector<int> ids;
+
+	auto count = struct_mapping::map_json_stream<Struct_stream_record>(std::string_view(json_data), [&] (const Struct_stream_record & record) {
+		ids.push_back(record.id);
+		return record.id != 2;
+	});
+
+	ASSERT_EQ(count, 2);
+	ASSERT_THAT(ids, ElementsAre(1, 2));
+}
+
+TEST(struct_mapping_map_json_to_struct, stream_parallel) {
+	struct_mapping::reg(&Struct_stream_record::id, "id");
+	struct_mapping::reg(&Struct_stream_record::level, "level");
+	struct_mapping::reg(&Struct_stream_record::tags, "tags");
+
+	std::string json_data;
+	for (int i = 0; i < 1000; ++i) {
+		json_data += "{\"id\": " + std::to_string(i) + ", \"level\": \"info\", \"tags\": [\"" + std::to_string(i % 7) + "\"]}\n";
+	}
+
+	std::vector<int> ids;
+	bool tags_ok = true;
+	auto count = struct_mapping::map_json_stream<Struct_stream_record>(std::string_view(json_data), [&] (const Struct_stream_record & record) {
+		ids.push_back(record.id);
+		tags_ok = tags_ok && record.level == "info" && record.tags == std::vector<std::string>{std::to_string(record.id % 7)};
+	}, struct_mapping::Parallel{4, 10});
+
+	ASSERT_EQ(count, 1000);
+	ASSERT_TRUE(tags_ok);
+	for (int i = 0; i < 1000; ++i) ASSERT_EQ(ids[static_cast<std::size_t>(i)], i);
+
+	ids.clear();
+	count = struct_mapping::map_json_stream<Struct_stream_record>(std::string_view(json_data), [&] (const Struct_stream_record & record) {
+		ids.push_back(record.id);
+		return record.id != 500;
+	}, struct_mapping::Parallel{4, 10});
+
+	ASSERT_EQ(count, 501);
+	ASSERT_EQ(ids.back(), 500);
+}
+
+TEST(struct_mapping_map_json_to_struct, stream_parallel_unordered) {
+	struct_mapping::reg(&Struct_stream_record::id, "id");
+	struct_mapping::reg(&Struct_stream_record::level, "level");
+	struct_mapping::reg(&Struct_stream_record::tags, "tags");
+
+	std::string json_data;
+	for (int i = 0; i < 1000; ++i) json_data += "{\"id\": " + std::to_string(i) + ", \"tags\": [\"a\", \"b\"]}\n";
+
+	std::mutex mutex;
+	std::set<int> ids;
+	auto count = struct_mapping::map_json_stream<Struct_stream_record>(std::string_view(json_data), [&] (const Struct_stream_record & record) {
+		std::lock_guard lock(mutex);
+		if (record.tags.size() == 2) ids.insert(record.id);
+	}, struct_mapping::Parallel{4, 10, false});
+
+	ASSERT_EQ(count, 1000);
+	ASSERT_EQ(ids.size(), 1000);
+
+	json_data += "{\"id\": \"bad\"}\n";
+	try {
+		struct_mapping::map_json_stream<Struct_stream_record>(std::string_view(json_data), [] (const Struct_stream_record &) {}, struct_mapping::Parallel{4, 10, false});
+	} catch (struct_mapping::StructMappingException &) {
+		return;
+	}
+
+	FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws nothing";
+}
+
+
+TEST(struct_mapping_map_json_to_struct, array) {
+	struct_mapping::reg(&Struct_stream_record::id, "id");
+	struct_mapping::reg(&Struct_stream_record::level, "level");
+	struct_mapping::reg(&Struct_stream_record::tags, "tags");
+
+	std::string json_data(R"json(
+	[
+		{"id": 1, "level": "info", "tags": ["a", "b"]},
+		{"id": 2, "tags": []},
+		{"id": 3, "level": "error"}
+	]
+	)json");
+
+	std::vector<Struct_stream_record> records;
+	std::istringstream json_stream(json_data);
+	struct_mapping::map_json_array(records, json_stream);
+
+	ASSERT_EQ(records.size(), 3);
+	ASSERT_EQ(records[0].id, 1);
+	ASSERT_THAT(records[0].tags, ElementsAre("a", "b"));
+	ASSERT_EQ(records[1].level, "");
+	ASSERT_EQ(records[2].level, "error");
+	ASSERT_TRUE(records[2].tags.empty());
+
+	std::vector<Struct_stream_record> copied;
+	auto count = struct_mapping::map_json_array<Struct_stream_record>(std::string_view(json_data), std::back_inserter(copied));
+
+	ASSERT_EQ(count, 3);
+	ASSERT_EQ(copied.size(), 3);
+	ASSERT_EQ(copied[2].id, 3);
+
+	struct_mapping::map_json_array(records, std::string_view("[]"));
+	ASSERT_TRUE(records.empty());
+}
+
+TEST(struct_mapping_map_json_to_struct, array_stream) {
+	struct_mapping::reg(&Struct_stream_record::id, "id");
+	struct_mapping::reg(&Struct_stream_record::level, "level");
+	struct_mapping::reg(&Struct_stream_record::tags, "tags");
+
+	std::string json_data("[");
+	for (int i = 0; i < 10000; ++i) json_data += (i == 0 ? "" : ",\n") + std::string("{\"id\": ") + std::to_string(i) + ", \"tags\": [\"x\"]}";
+	json_data += "] tail";
+	std::istringstream json_stream(json_data);
+
+	long long sum = 0;
+	auto count = struct_mapping::map_json_array<Struct_stream_record>(json_stream, [&] (const Struct_stream_record & record) {
+		sum += record.id;
+	});
+
+	ASSERT_EQ(count, 10000);
+	ASSERT_EQ(sum, 10000LL * 9999 / 2);
+
+	std::string rest;
+	std::getline(json_stream, rest);
+	ASSERT_EQ(rest, " tail");
+
+	std::istringstream json_stop("[{\"id\": 1}, {\"id\": 2}, {\"id\": 3}]");
+	count = struct_mapping::map_json_array<Struct_stream_record>(json_stop, [] (const Struct_stream_record & record) {
+		return record.id < 2;
+	});
+
+	ASSERT_EQ(count, 2);
+}
+
+TEST(struct_mapping_map_json_to_struct, array_parallel) {
+	struct_mapping::reg(&Struct_stream_record::id, "id");
+	struct_mapping::reg(&Struct_stream_record::level, "level");
+	struct_mapping::reg(&Struct_stream_record::tags, "tags");
+
+	std::string json_data("[\n");
+	for (int i = 0; i < 1000; ++i) {
+		if (i != 0) json_data += ",\n";
+		json_data += "  {\"id\": " + std::to_string(i) + ", \"level\": \"a,\\\"}{[,b\", \"tags\": [\"" + std::to_string(i) + "\", \"]\"]}";
+	}
+	json_data += "\n]";
+
+	std::vector<Struct_stream_record> records(3);
+	struct_mapping::map_json_array(records, std::string_view(json_data), struct_mapping::Parallel{4, 7});
+
+	ASSERT_EQ(records.size(), 1000);
+	for (int i = 0; i < 1000; ++i) {
+		auto & record = records[static_cast<std::size_t>(i)];
+		ASSERT_EQ(record.id, i);
+		ASSERT_EQ(record.level, "a,\"}{[,b");
+		ASSERT_THAT(record.tags, ElementsAre(std::to_string(i), "]"));
+	}
+
+	struct_mapping::map_json_array(records, std::string_view("[ ]"), struct_mapping::Parallel{4, 7});
+	ASSERT_TRUE(records.empty());
+
+	try {
+		struct_mapping::map_json_array(records, std::string_view("[{\"id\": 1}, {\"id\": 2}, {\"id\": \"bad\"}, {\"id\": 4}]"), struct_mapping::Parallel{2, 1});
+	} catch (struct_mapping::StructMappingException &) {
+		return;
+	}
+
+	FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws nothing";
+}
+
 }
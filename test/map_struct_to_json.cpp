@@ -1,6 +1,7 @@
 #include <cstdint>
 #include <list>
 #include <map>
+#include <memory_resource>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -273,4 +274,282 @@ R"json({
 	ASSERT_EQ(result_json.str(), expected_json);
 }
 
+
+TEST(struct_mapping_mapper_json_size, test_complex) {
+	ComplexBook source;
+
+	source.price = 12.35;
+	source.free = false;
+	source.author.name = "Gogol";
+	source.author.birth_year = 1809;
+	source.chapters.push_back(std::string("B 1999"));
+	source.chapters.push_back(std::string("M 1998"));
+	source.chapters.push_back(std::string("E 1997"));
+
+	std::ostringstream result_json;
+	struct_mapping::map_struct_to_json(source, result_json);
+
+	ASSERT_EQ(struct_mapping::json_size(source), result_json.str().size());
+}
+
+TEST(struct_mapping_mapper_map_struct_to_json_buffer, test_complex) {
+	ComplexBook source;
+
+	source.price = 12.35;
+	source.free = false;
+	source.author.name = "Gogol";
+	source.author.birth_year = 1809;
+	source.chapters.push_back(std::string("B 1999"));
+
+	std::string expected_json(R"json({"price":12.35,"free":false,"author":{"name":"Gogol","birth_year":1809},"chapters":["B 1999"]})json");
+
+	std::vector<char> buffer(struct_mapping::json_size(source));
+	auto size = struct_mapping::map_struct_to_json(source, buffer.data(), buffer.size());
+
+	ASSERT_EQ(size, expected_json.size());
+	ASSERT_EQ(std::string(buffer.data(), size), expected_json);
+}
+
+TEST(struct_mapping_mapper_map_struct_to_json_buffer, test_capacity_too_small) {
+	Struct source;
+
+	source.a.value = 42;
+	source.b.value = 2020;
+
+	char buffer[16] = "###############";
+	auto size = struct_mapping::map_struct_to_json(source, buffer, 10);
+
+	ASSERT_EQ(size, std::string(R"json({"a":{"value":42},"b":{"value":2020}})json").size());
+	ASSERT_EQ(std::string(buffer + 10), std::string("#####"));
+}
+
+
+TEST(struct_mapping_stream_writer, test_array) {
+	std::vector<Struct_A> source(3);
+	source[0].value = 1;
+	source[1].value = 2;
+	source[2].value = 3;
+
+	std::ostringstream result_json;
+	auto count = struct_mapping::map_range_to_json(source, result_json);
+
+	ASSERT_EQ(count, 3);
+	ASSERT_EQ(result_json.str(), std::string(R"json([{"value":1},{"value":2},{"value":3}])json"));
+}
+
+TEST(struct_mapping_stream_writer, test_empty_array) {
+	std::vector<Struct_A> source;
+
+	std::ostringstream result_json;
+	struct_mapping::map_range_to_json(source, result_json);
+
+	ASSERT_EQ(result_json.str(), std::string("[]"));
+}
+
+TEST(struct_mapping_stream_writer, test_lines_generator) {
+	int next = 0;
+	auto generator = [&next] (Struct_A & value) {
+		value.value = next;
+		return next++ != 3;
+	};
+
+	std::ostringstream result_json;
+	auto count = struct_mapping::map_generator_to_json<Struct_A>(generator, result_json, struct_mapping::StreamFormat::Lines);
+
+	ASSERT_EQ(count, 3);
+	ASSERT_EQ(result_json.str(), std::string("{\"value\":0}\n{\"value\":1}\n{\"value\":2}\n"));
+}
+
+TEST(struct_mapping_stream_writer, test_flush_threshold) {
+	Struct_A source;
+	std::ostringstream result_json;
+	struct_mapping::StreamWriter<Struct_A> writer(result_json, struct_mapping::StreamFormat::Array, 16);
+
+	source.value = 1;
+	writer.write(source);
+	ASSERT_EQ(result_json.str(), std::string(""));
+
+	source.value = 2;
+	writer.write(source);
+	ASSERT_EQ(result_json.str(), std::string(R"json([{"value":1},{"value":2})json"));
+
+	writer.finish();
+	ASSERT_EQ(result_json.str(), std::string(R"json([{"value":1},{"value":2}])json"));
+}
+
+
+struct ParallelElement {
+	int id;
+	std::string name;
+	std::vector<int> values;
+};
+
+struct ParallelSnapshot {
+	std::string title;
+	std::vector<ParallelElement> elements;
+};
+
+class VectoredSink {
+public:
+	void write(const char * data, std::size_t size) {
+		result.append(data, size);
+	}
+
+	void writev(const std::string_view * parts, std::size_t count) {
+		++writev_count;
+		for (std::size_t i = 0; i < count; ++i) result.append(parts[i]);
+	}
+
+	std::string result;
+	std::size_t writev_count = 0;
+};
+
+TEST(struct_mapping_mapper_map_struct_to_json_parallel, test_elements) {
+	struct_mapping::reg(&ParallelElement::id, "id");
+	struct_mapping::reg(&ParallelElement::name, "name");
+	struct_mapping::reg(&ParallelElement::values, "values");
+	struct_mapping::reg(&ParallelSnapshot::title, "title");
+	struct_mapping::reg(&ParallelSnapshot::elements, "elements");
+
+	ParallelSnapshot source;
+	source.title = "snapshot";
+	for (int i = 0; i < 1000; ++i) source.elements.push_back(ParallelElement{i, "element_" + std::to_string(i), {i, i + 1, i + 2}});
+
+	std::ostringstream expected_json;
+	struct_mapping::map_struct_to_json(source, expected_json);
+
+	std::ostringstream result_json;
+	struct_mapping::map_struct_to_json(source, result_json, struct_mapping::Parallel{4, 7});
+
+	ASSERT_EQ(result_json.str(), expected_json.str());
+
+	VectoredSink sink;
+	struct_mapping::map_struct_to_json(source, sink, struct_mapping::Parallel{3, 100});
+
+	ASSERT_EQ(sink.result, expected_json.str());
+	ASSERT_EQ(sink.writev_count, 2);
+}
+
+TEST(struct_mapping_mapper_map_struct_to_json_parallel, test_small) {
+	ParallelSnapshot source;
+	source.title = "small";
+	source.elements.push_back(ParallelElement{1, "one", {}});
+
+	std::ostringstream result_json;
+	struct_mapping::map_struct_to_json(source, result_json, struct_mapping::Parallel{2, 1024});
+
+	ASSERT_EQ(result_json.str(), std::string(R"json({"title":"small","elements":[{"id":1,"name":"one","values":[]}]})json"));
+}
+
+
+struct NumericArrays {
+	std::vector<float> a;
+	std::vector<double> b;
+	std::list<int> c;
+	std::vector<unsigned char> d;
+};
+
+TEST(struct_mapping_mapper_map_struct_to_json, test_numeric_arrays) {
+	struct_mapping::reg(&NumericArrays::a, "a");
+	struct_mapping::reg(&NumericArrays::b, "b");
+	struct_mapping::reg(&NumericArrays::c, "c");
+	struct_mapping::reg(&NumericArrays::d, "d");
+
+	NumericArrays source;
+	source.a = {0.5f, -1.25f, 3.0f};
+	source.b = {1e100, 14.768, -0.001};
+	source.c = {-3, 0, 12};
+	source.d = {0, 255};
+
+	std::ostringstream result_json;
+	struct_mapping::map_struct_to_json(source, result_json);
+
+	std::string expected_json(R"json({"a":[0.5,-1.25,3],"b":[1e+100,14.768,-0.001],"c":[-3,0,12],"d":[0,255]})json");
+
+	ASSERT_EQ(result_json.str(), expected_json);
+	ASSERT_EQ(struct_mapping::json_size(source), expected_json.size());
+}
+
+TEST(struct_mapping_mapper_map_struct_to_json, test_numeric_arrays_large) {
+	NumericArrays source;
+	std::ostringstream expected_json;
+
+	expected_json << R"json({"a":[],"b":[)json";
+	for (int i = 0; i < 10000; ++i) {
+		source.b.push_back(i / 7.0);
+		if (i != 0) expected_json << ",";
+		expected_json << i / 7.0;
+	}
+	expected_json << R"json(],"c":[],"d":[]})json";
+
+	std::ostringstream result_json;
+	struct_mapping::map_struct_to_json(source, result_json);
+
+	ASSERT_EQ(result_json.str(), expected_json.str());
+}
+
+
+struct PmrStrings {
+	std::pmr::string name;
+	std::pmr::vector<std::pmr::string> names;
+	std::pmr::map<std::pmr::string, std::pmr::string> attributes;
+};
+
+TEST(struct_mapping_mapper_map_struct_to_json, test_pmr_strings) {
+	struct_mapping::reg(&PmrStrings::name, "name");
+	struct_mapping::reg(&PmrStrings::names, "names");
+	struct_mapping::reg(&PmrStrings::attributes, "attributes");
+
+	std::pmr::monotonic_buffer_resource resource;
+	PmrStrings source{std::pmr::string("first", &resource), {}, {}};
+	source.names.emplace_back("second");
+	source.attributes.emplace("key", "value");
+
+	std::ostringstream result_json;
+	struct_mapping::map_struct_to_json(source, result_json);
+
+	ASSERT_EQ(result_json.str(), std::string(R"json({"name":"first","names":["second"],"attributes":{"key":"value"}})json"));
+}
+
+
+struct Escapes {
+	std::string value;
+};
+
+TEST(struct_mapping_mapper_map_struct_to_json, test_escapes) {
+	struct_mapping::reg(&Escapes::value, "value");
+
+	Escapes source{"quote \" backslash \\ controls \n\t\x01"};
+
+	std::ostringstream result_json;
+	struct_mapping::map_struct_to_json(source, result_json);
+
+	ASSERT_EQ(result_json.str(), std::string(R"json({"value":"quote \" backslash \\ controls \n\t\u0001"})json"));
+}
+
+
+struct Struct_raw_json {
+	std::string name;
+	struct_mapping::RawJson payload;
+	struct_mapping::RawJson empty;
+	std::vector<struct_mapping::RawJson> list;
+};
+
+TEST(struct_mapping_mapper_map_struct_to_json, test_raw_json) {
+	Struct_raw_json source;
+
+	struct_mapping::reg(&Struct_raw_json::name, "name");
+	struct_mapping::reg(&Struct_raw_json::payload, "payload");
+	struct_mapping::reg(&Struct_raw_json::empty, "empty");
+	struct_mapping::reg(&Struct_raw_json::list, "list");
+
+	std::istringstream json_data(R"json({"name":"first","payload":{"a": [1, 2]},"list":[{},"x",3]})json");
+	struct_mapping::map_json_to_struct(source, json_data);
+
+	std::ostringstream result_json;
+	struct_mapping::map_struct_to_json(source, result_json);
+
+	ASSERT_EQ(result_json.str(), R"json({"name":"first","payload":{"a": [1, 2]},"empty":null,"list":[{},"x",3]})json");
+}
+
 }
@@ -0,0 +1,110 @@
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "struct_mapping/struct_mapping.h"
+
+using ::testing::ElementsAre;
+using ::testing::Pair;
+using ::testing::UnorderedElementsAre;
+
+namespace {
+
+struct Struct_reserve_vector {
+	std::vector<int> values;
+	std::vector<std::string> names;
+};
+
+TEST(option_reserve, vector) {
+	Struct_reserve_vector result_struct;
+
+	struct_mapping::reg(&Struct_reserve_vector::values, "values", struct_mapping::Reserve{100});
+	struct_mapping::reg(&Struct_reserve_vector::names, "names", struct_mapping::Reserve{100});
+
+	std::istringstream json_data(R"json(
+	{
+		"values": [1, 2, 3],
+		"names": ["first", "second"]
+	}
+	)json");
+
+	struct_mapping::map_json_to_struct(result_struct, json_data);
+
+	ASSERT_THAT(result_struct.values, ElementsAre(1, 2, 3));
+	ASSERT_GE(result_struct.values.capacity(), 100);
+	ASSERT_THAT(result_struct.names, ElementsAre("first", "second"));
+	ASSERT_GE(result_struct.names.capacity(), 100);
+}
+
+struct Struct_reserve_set {
+	std::set<int> ordered;
+	std::unordered_set<std::string> unordered;
+};
+
+TEST(option_reserve, set) {
+	Struct_reserve_set result_struct;
+
+	struct_mapping::reg(&Struct_reserve_set::ordered, "ordered", struct_mapping::Reserve{100});
+	struct_mapping::reg(&Struct_reserve_set::unordered, "unordered", struct_mapping::Reserve{100});
+
+	std::istringstream json_data(R"json(
+	{
+		"ordered": [3, 1, 2, 3],
+		"unordered": ["first", "second", "first"]
+	}
+	)json");
+
+	struct_mapping::map_json_to_struct(result_struct, json_data);
+
+	ASSERT_THAT(result_struct.ordered, ElementsAre(1, 2, 3));
+	ASSERT_THAT(result_struct.unordered, UnorderedElementsAre("first", "second"));
+	ASSERT_GE(result_struct.unordered.bucket_count(), 100);
+}
+
+struct Struct_reserve_map {
+	std::unordered_map<std::string, int> values;
+};
+
+TEST(option_reserve, unordered_map) {
+	Struct_reserve_map result_struct;
+
+	struct_mapping::reg(&Struct_reserve_map::values, "values", struct_mapping::Reserve{100});
+
+	std::istringstream json_data(R"json(
+	{
+		"values": {
+			"first": 1,
+			"second": 2
+		}
+	}
+	)json");
+
+	struct_mapping::map_json_to_struct(result_struct, json_data);
+
+	ASSERT_THAT(result_struct.values, UnorderedElementsAre(Pair("first", 1), Pair("second", 2)));
+	ASSERT_GE(result_struct.values.bucket_count(), 100);
+}
+
+struct Struct_reserve_negative {
+	std::vector<int> values;
+};
+
+TEST(option_reserve, negative_size) {
+	try {
+		struct_mapping::reg(&Struct_reserve_negative::values, "values", struct_mapping::Reserve{-1});
+	} catch (struct_mapping::StructMappingException& e) {
+		return;
+	} catch (...) {
+		FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws a different type";
+	}
+
+	FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws nothing";
+}
+
+}
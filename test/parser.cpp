@@ -2,6 +2,7 @@
 #include <cstring>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <utility>
 
@@ -904,4 +905,128 @@ TEST(parser, exception_bad_number_out_of_range) {
 	FAIL() << "Expected: throws an exception of type ExceptionBadNumber\n  Actual: it throws nothing";
 }
 
+
+TEST(parser, values_across_input_buffer) {
+	std::string long_string(40000, 'x');
+	std::string source("{\"name_1\": \"" + long_string + "\", \"name_2\": [");
+	for (int i = 0; i < 10000; ++i) source += (i == 0 ? "" : ", ") + std::to_string(i * 1000003LL);
+	source += "]}{\"next\": 1}";
+	std::istringstream data(source);
+
+	std::vector<long long> integrals;
+	std::string string_value;
+
+	auto set_bool = [] (std::string const &, bool) {};
+	auto set_integral = [&integrals] (std::string const &, long long value) {integrals.push_back(value);};
+	auto set_floating_point = [] (std::string const &, double) {};
+	auto set_string = [&string_value] (std::string const &, std::string const & value) {string_value = value;};
+	auto set_null = [] (std::string const &) {};
+	auto start_struct = [] (std::string const &) {};
+	auto end_struct = [] {};
+	auto start_array = [] (std::string const &) {};
+	auto end_array = [] {};
+
+	struct_mapping::detail::Parser jp(
+		set_bool,
+		set_integral,
+		set_floating_point,
+		set_string,
+		set_null,
+		start_struct,
+		end_struct,
+		start_array,
+		end_array);
+	jp.parse(&data);
+
+	ASSERT_EQ(string_value, long_string);
+	ASSERT_EQ(integrals.size(), 10000);
+	for (std::size_t i = 0; i < 10000; ++i) ASSERT_EQ(integrals[i], static_cast<long long>(i) * 1000003LL);
+
+	std::string rest;
+	std::getline(data, rest);
+	ASSERT_EQ(rest, std::string("{\"next\": 1}"));
+}
+
+
+TEST(parser, string_views_across_input_buffer) {
+	std::string source("{\"name\": [");
+	std::vector<std::string> expected;
+	for (int i = 0; i < 2000; ++i) {
+		expected.push_back(std::string(static_cast<std::size_t>(i % 50), 'a') + std::to_string(i));
+		source += (i == 0 ? "\"" : ", \"") + expected.back() + "\"";
+	}
+	source += "]}";
+	std::istringstream data(source);
+
+	std::vector<std::string> strings;
+
+	auto set_bool = [] (std::string const &, bool) {};
+	auto set_integral = [] (std::string const &, long long) {};
+	auto set_floating_point = [] (std::string const &, double) {};
+	auto set_string = [&strings] (std::string const &, std::string_view value) {strings.emplace_back(value);};
+	auto set_null = [] (std::string const &) {};
+	auto start_struct = [] (std::string const &) {};
+	auto end_struct = [] {};
+	auto start_array = [] (std::string const &) {};
+	auto end_array = [] {};
+
+	struct_mapping::detail::Parser jp(
+		set_bool,
+		set_integral,
+		set_floating_point,
+		set_string,
+		set_null,
+		start_struct,
+		end_struct,
+		start_array,
+		end_array);
+	jp.parse(&data);
+
+	ASSERT_EQ(strings, expected);
+}
+
+
+TEST(parser, raw_values_across_input_buffer) {
+	std::string payload("[");
+	for (int i = 0; i < 5000; ++i) payload += (i == 0 ? "" : ", ") + std::string("{\"v\": \"") + std::to_string(i) + "\\\"]}\"}";
+	payload += "]";
+	std::istringstream data("{\"payload\": " + payload + ", \"scalar\": 123456789, \"next\": 1}");
+
+	std::vector<std::string> raws;
+	long long next = 0;
+
+	auto set_bool = [] (std::string const &, bool) {};
+	auto set_integral = [&next] (std::string const &, long long value) {next = value;};
+	auto set_floating_point = [] (std::string const &, double) {};
+	auto set_string = [] (std::string const &, std::string const &) {};
+	auto set_null = [] (std::string const &) {};
+	auto start_struct = [] (std::string const &) {};
+	auto end_struct = [] {};
+	auto start_array = [] (std::string const &) {};
+	auto end_array = [] {};
+	auto get_value_action = [] (std::string const & name) {
+		return name == "next" ? struct_mapping::detail::ValueAction::Map : struct_mapping::detail::ValueAction::Capture;
+	};
+	auto set_raw = [&raws] (std::string const &, std::string_view value) {raws.emplace_back(value);};
+
+	struct_mapping::detail::Parser jp(
+		set_bool,
+		set_integral,
+		set_floating_point,
+		set_string,
+		set_null,
+		start_struct,
+		end_struct,
+		start_array,
+		end_array,
+		get_value_action,
+		set_raw);
+	jp.parse(&data);
+
+	ASSERT_EQ(raws.size(), 2);
+	ASSERT_EQ(raws[0], payload);
+	ASSERT_EQ(raws[1], "123456789");
+	ASSERT_EQ(next, 1);
+}
+
 }
@@ -0,0 +1,124 @@
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "struct_mapping/struct_mapping.h"
+
+using ::testing::ElementsAre;
+
+namespace {
+
+struct Struct_pipeline_record {
+	int id = 0;
+	std::string_view level;
+	std::vector<int> values;
+};
+
+void reg_pipeline() {
+	struct_mapping::reg(&Struct_pipeline_record::id, "id");
+	struct_mapping::reg(&Struct_pipeline_record::level, "level");
+	struct_mapping::reg(&Struct_pipeline_record::values, "values");
+}
+
+std::string records(int count) {
+	std::string json_data;
+	for (int i = 0; i < count; ++i) {
+		json_data += "{\"id\": " + std::to_string(i) + ", \"level\": \"l" + std::to_string(i % 3) + "\", \"values\": [" + std::to_string(i) + ", 1]}\n";
+	}
+	return json_data;
+}
+
+TEST(struct_mapping_pipeline, ordered) {
+	reg_pipeline();
+
+	std::istringstream json_data(records(2000) + "\n  \n");
+	std::vector<int> ids;
+	bool values_ok = true;
+
+	auto count = struct_mapping::map_json_stream<Struct_pipeline_record>(json_data, [&] (const Struct_pipeline_record & record) {
+		ids.push_back(record.id);
+		values_ok = values_ok && record.level == "l" + std::to_string(record.id % 3) && record.values == std::vector<int>{record.id, 1};
+	}, struct_mapping::Pipeline{4, 100, 2});
+
+	ASSERT_EQ(count, 2000);
+	ASSERT_TRUE(values_ok);
+	for (int i = 0; i < 2000; ++i) ASSERT_EQ(ids[static_cast<std::size_t>(i)], i);
+}
+
+TEST(struct_mapping_pipeline, unordered) {
+	reg_pipeline();
+
+	std::istringstream json_data(records(2000));
+	std::mutex mutex;
+	std::set<int> ids;
+
+	auto count = struct_mapping::map_json_stream<Struct_pipeline_record>(json_data, [&] (const Struct_pipeline_record & record) {
+		std::lock_guard lock(mutex);
+		ids.insert(record.id);
+	}, struct_mapping::Pipeline{4, 4096, 2, false});
+
+	ASSERT_EQ(count, 2000);
+	ASSERT_EQ(ids.size(), 2000);
+}
+
+TEST(struct_mapping_pipeline, transform) {
+	reg_pipeline();
+
+	auto encoded = records(500);
+	for (auto & ch : encoded) ch = static_cast<char>(ch ^ 1);
+	std::istringstream json_data(encoded);
+
+	struct_mapping::Pipeline pipeline{2, 64, 3};
+	pipeline.transform = [] (std::string_view block) {
+		std::string decoded(block);
+		for (auto & ch : decoded) ch = static_cast<char>(ch ^ 1);
+		return decoded;
+	};
+
+	std::vector<int> ids;
+	auto count = struct_mapping::map_json_stream<Struct_pipeline_record>(json_data, [&] (const Struct_pipeline_record & record) {
+		ids.push_back(record.id);
+	}, pipeline);
+
+	ASSERT_EQ(count, 500);
+	ASSERT_EQ(ids.front(), 0);
+	ASSERT_EQ(ids.back(), 499);
+}
+
+TEST(struct_mapping_pipeline, stop) {
+	reg_pipeline();
+
+	std::istringstream json_data(records(5000));
+	std::vector<int> ids;
+
+	auto count = struct_mapping::map_json_stream<Struct_pipeline_record>(json_data, [&] (const Struct_pipeline_record & record) {
+		ids.push_back(record.id);
+		return record.id != 10;
+	}, struct_mapping::Pipeline{2, 256, 1});
+
+	ASSERT_EQ(count, 11);
+	ASSERT_EQ(ids.back(), 10);
+}
+
+TEST(struct_mapping_pipeline, bad_record) {
+	reg_pipeline();
+
+	std::istringstream json_data(records(1000) + "{\"id\": \"bad\"}\n" + records(1000));
+
+	try {
+		struct_mapping::map_json_stream<Struct_pipeline_record>(json_data, [] (const Struct_pipeline_record &) {}, struct_mapping::Pipeline{4, 512, 2});
+	} catch (struct_mapping::StructMappingException & e) {
+		ASSERT_STREQ(e.what(), "bad type (string) for member: id");
+		return;
+	}
+
+	FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws nothing";
+}
+
+}
@@ -0,0 +1,105 @@
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "struct_mapping/struct_mapping.h"
+
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+namespace {
+
+struct Struct_push_item {
+	int id = 0;
+	std::string name;
+};
+
+struct Struct_push {
+	bool flag = false;
+	long long big = 0;
+	double price = 0;
+	std::string text;
+	std::vector<int> numbers;
+	std::vector<Struct_push_item> items;
+	std::map<std::string, double> rates;
+	struct_mapping::RawJson raw;
+	Struct_push_item nested;
+};
+
+const std::string json_data(R"json(
+{
+	"flag": true,
+	"big": -1234567890123,
+	"price": 1.25e2,
+	"text": "tab\tquote\"unicodeé",
+	"numbers": [1, 22, 333],
+	"items": [{"id": 1, "name": "one"}, {"id": 2, "name": "two"}],
+	"rates": {"usd": 1.5, "eur": 0.5},
+	"raw": {"a": [1, "]}\""], "b": null},
+	"nested": {"id": 7, "name": null}
+}
+)json");
+
+void reg_push() {
+	struct_mapping::reg(&Struct_push_item::id, "id");
+	struct_mapping::reg(&Struct_push_item::name, "name");
+	struct_mapping::reg(&Struct_push::flag, "flag");
+	struct_mapping::reg(&Struct_push::big, "big");
+	struct_mapping::reg(&Struct_push::price, "price");
+	struct_mapping::reg(&Struct_push::text, "text");
+	struct_mapping::reg(&Struct_push::numbers, "numbers");
+	struct_mapping::reg(&Struct_push::items, "items");
+	struct_mapping::reg(&Struct_push::rates, "rates");
+	struct_mapping::reg(&Struct_push::raw, "raw");
+	struct_mapping::reg(&Struct_push::nested, "nested");
+}
+
+TEST(push_parser, chunks_of_any_size) {
+	reg_push();
+
+	for (std::size_t chunk_size = 1; chunk_size <= json_data.size(); ++chunk_size) {
+		Struct_push result_struct;
+		struct_mapping::PushMapper mapper(result_struct);
+
+		for (std::size_t i = 0; i < json_data.size(); i += chunk_size) {
+			ASSERT_EQ(mapper.feed(std::string_view(json_data).substr(i, chunk_size)), i + chunk_size > json_data.rfind('}'));
+		}
+
+		ASSERT_TRUE(mapper.done());
+		ASSERT_EQ(result_struct.flag, true);
+		ASSERT_EQ(result_struct.big, -1234567890123LL);
+		ASSERT_EQ(result_struct.price, 125.0);
+		ASSERT_EQ(result_struct.text, "tab\tquote\"unicode\xc3\xa9");
+		ASSERT_THAT(result_struct.numbers, ElementsAre(1, 22, 333));
+		ASSERT_EQ(result_struct.items.size(), 2);
+		ASSERT_EQ(result_struct.items[1].id, 2);
+		ASSERT_EQ(result_struct.items[1].name, "two");
+		ASSERT_THAT(result_struct.rates, ElementsAre(Pair("eur", 0.5), Pair("usd", 1.5)));
+		ASSERT_EQ(result_struct.raw.get(), R"json({"a": [1, "]}\""], "b": null})json");
+		ASSERT_EQ(result_struct.nested.id, 7);
+	}
+}
+
+TEST(push_parser, bad_character) {
+	reg_push();
+
+	Struct_push result_struct;
+	struct_mapping::PushMapper mapper(result_struct);
+	mapper.feed("{\"flag\": tr");
+
+	try {
+		mapper.feed("ue, \"big\": 1 2}");
+	} catch (struct_mapping::StructMappingException& e) {
+		return;
+	} catch (...) {
+		FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws a different type";
+	}
+
+	FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws nothing";
+}
+
+}
@@ -0,0 +1,123 @@
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "struct_mapping/struct_mapping.h"
+
+using ::testing::ElementsAre;
+
+namespace {
+
+struct Struct_tape_item {
+	int id = 0;
+	std::string_view name;
+};
+
+struct Struct_tape_business {
+	long long order = 0;
+	double price = 0;
+	std::vector<Struct_tape_item> items;
+};
+
+struct Struct_tape_audit {
+	std::string user;
+	bool trusted = false;
+	struct_mapping::RawJson items;
+};
+
+const std::string json_data(R"json(
+{
+	"order": 12345678901,
+	"user": "first \"user\"",
+	"price": 12.5,
+	"trusted": true,
+	"items": [{"id": 1, "name": "one", "note": null}, {"id": 2, "name": "two\tthree"}]
+}
+)json");
+
+void reg_tape() {
+	struct_mapping::reg(&Struct_tape_item::id, "id");
+	struct_mapping::reg(&Struct_tape_item::name, "name");
+	struct_mapping::reg(&Struct_tape_business::order, "order");
+	struct_mapping::reg(&Struct_tape_business::price, "price");
+	struct_mapping::reg(&Struct_tape_business::items, "items");
+	struct_mapping::reg(&Struct_tape_audit::user, "user");
+	struct_mapping::reg(&Struct_tape_audit::trusted, "trusted");
+	struct_mapping::reg(&Struct_tape_audit::items, "items");
+}
+
+TEST(tape, map_into_several_types) {
+	reg_tape();
+
+	struct_mapping::Tape tape;
+	tape.parse(json_data);
+
+	Struct_tape_business business;
+	struct_mapping::map_json_to_struct(business, tape, struct_mapping::IgnoreUnknown{});
+
+	ASSERT_EQ(business.order, 12345678901LL);
+	ASSERT_EQ(business.price, 12.5);
+	ASSERT_EQ(business.items.size(), 2);
+	ASSERT_EQ(business.items[0].id, 1);
+	ASSERT_EQ(business.items[0].name, "one");
+	ASSERT_EQ(business.items[1].name, "two\tthree");
+
+	Struct_tape_audit audit;
+	struct_mapping::map_json_to_struct(audit, tape, struct_mapping::IgnoreUnknown{});
+
+	ASSERT_EQ(audit.user, "first \"user\"");
+	ASSERT_EQ(audit.trusted, true);
+	ASSERT_EQ(audit.items.get(), R"json([{"id":1,"name":"one","note":null},{"id":2,"name":"two\tthree"}])json");
+
+	Struct_tape_business repeated;
+	struct_mapping::map_json_to_struct(repeated, tape, struct_mapping::IgnoreUnknown{});
+
+	ASSERT_EQ(repeated.items.size(), 2);
+	ASSERT_EQ(repeated.items[1].id, 2);
+}
+
+TEST(tape, tokens) {
+	struct_mapping::Tape tape;
+	std::istringstream json_stream(R"json({"a": [1, 2.5], "b": {"c": "d"}})json");
+	tape.parse(json_stream);
+
+	auto & tokens = tape.get_tokens();
+	std::vector<struct_mapping::Tape::Type> types;
+	for (auto & token : tokens) types.push_back(token.type);
+
+	using Type = struct_mapping::Tape::Type;
+	ASSERT_THAT(types, ElementsAre(
+		Type::StartStruct, Type::StartArray, Type::Integral, Type::FloatingPoint, Type::EndArray,
+		Type::StartStruct, Type::String, Type::EndStruct, Type::EndStruct));
+	ASSERT_EQ(tokens[0].end, 8);
+	ASSERT_EQ(tokens[1].end, 4);
+	ASSERT_EQ(tape.get_name(tokens[1]), "a");
+	ASSERT_EQ(tokens[2].integral_value, 1);
+	ASSERT_EQ(tokens[3].floating_point_value, 2.5);
+	ASSERT_EQ(tape.get_name(tokens[6]), "c");
+	ASSERT_EQ(tape.get_string(tokens[6]), "d");
+}
+
+TEST(tape, bad_member) {
+	reg_tape();
+
+	struct_mapping::Tape tape;
+	tape.parse(json_data);
+
+	Struct_tape_business business;
+	try {
+		struct_mapping::map_json_to_struct(business, tape);
+	} catch (struct_mapping::StructMappingException& e) {
+		return;
+	} catch (...) {
+		FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws a different type";
+	}
+
+	FAIL() << "Expected: throws an exception of type StructMappingException\n  Actual: it throws nothing";
+}
+
+}